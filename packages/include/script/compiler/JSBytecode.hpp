@@ -0,0 +1,105 @@
+#pragma once
+#include "JSOperator.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+struct JSProgram;
+
+enum class JS_OPERAND_TYPE {
+  NONE = 0,
+  COUNT,
+  NUMBER,
+  ADDRESS,
+  IDENTIFIER,
+  STRING,
+  REGEX,
+  BIGINT,
+  LAZY,
+};
+
+// one byte per opcode and at most one operand after it: counts and
+// constant indices are LEB128 varints, numbers are 8 raw bytes and
+// addresses are 4-byte offsets from the operand itself. LAZY keeps a fixed
+// 4-byte index so the stub can be rewritten into a JMP in place.
+class JSBytecode {
+public:
+  static constexpr size_t FIXED_SIZE = 4;
+
+  static constexpr size_t NUMBER_SIZE = 8;
+
+  static constexpr size_t MAX_VARINT_SIZE = 5;
+
+  static JS_OPERAND_TYPE getOperandType(const JS_OPERATOR &opt);
+
+  static const wchar_t *getOperatorName(const JS_OPERATOR &opt);
+
+  static void pushVarint(std::vector<uint8_t> &codes, uint32_t value) {
+    while (value >= 0x80) {
+      codes.push_back((uint8_t)(value | 0x80));
+      value >>= 7;
+    }
+    codes.push_back((uint8_t)value);
+  }
+
+  static void pushFixed(std::vector<uint8_t> &codes, uint32_t value) {
+    auto offset = codes.size();
+    codes.resize(offset + FIXED_SIZE);
+    setFixed(codes, offset, value);
+  }
+
+  static void pushNumber(std::vector<uint8_t> &codes, double value) {
+    auto offset = codes.size();
+    codes.resize(offset + NUMBER_SIZE);
+    std::memcpy(codes.data() + offset, &value, NUMBER_SIZE);
+  }
+
+  static void setFixed(std::vector<uint8_t> &codes, size_t offset,
+                       uint32_t value) {
+    std::memcpy(codes.data() + offset, &value, FIXED_SIZE);
+  }
+
+  static void setAddress(std::vector<uint8_t> &codes, size_t offset,
+                         size_t address) {
+    setFixed(codes, offset, (uint32_t)(int32_t)(address - offset));
+  }
+
+  static uint32_t readVarint(const uint8_t *codes, size_t &offset) {
+    uint32_t value = 0;
+    for (size_t shift = 0;; shift += 7) {
+      auto byte = codes[offset++];
+      value |= (uint32_t)(byte & 0x7f) << shift;
+      if (!(byte & 0x80)) {
+        break;
+      }
+    }
+    return value;
+  }
+
+  static uint32_t readFixed(const uint8_t *codes, size_t &offset) {
+    uint32_t value;
+    std::memcpy(&value, codes + offset, FIXED_SIZE);
+    offset += FIXED_SIZE;
+    return value;
+  }
+
+  static size_t readAddress(const uint8_t *codes, size_t &offset) {
+    auto base = offset;
+    auto delta = (int32_t)readFixed(codes, offset);
+    return (size_t)((ptrdiff_t)base + delta);
+  }
+
+  static double readNumber(const uint8_t *codes, size_t &offset) {
+    double value;
+    std::memcpy(&value, codes + offset, NUMBER_SIZE);
+    offset += NUMBER_SIZE;
+    return value;
+  }
+
+  // checks that codes from begin on split into whole instructions whose
+  // constant indices are in range and whose jumps land on one of them;
+  // fault receives the offset of the first bad instruction
+  static bool verify(const JSProgram &program, size_t begin = 0,
+                     size_t *fault = nullptr);
+};
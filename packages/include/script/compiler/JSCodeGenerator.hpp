@@ -1,4 +1,5 @@
 #pragma once
+#include "JSBytecode.hpp"
 #include "JSOperator.hpp"
 #include "JSParser.hpp"
 #include "JSProgram.hpp"
@@ -21,6 +22,7 @@ private:
   size_t _scope{};
   JSNode *_lexContext{};
   JSAllocator *_allocator;
+  bool _lazy{};
 
 private:
   JSNode *unwrap(JSNode *node) {
@@ -33,51 +35,55 @@ private:
   bool is(JSNode *node, const JS_NODE_TYPE &type) {
     return unwrap(node)->type == type;
   }
-  uint32_t resolveConstant(JSProgram &program, const std::wstring &constant) {
-    for (size_t index = 0; index < program.constants.size(); index++) {
-      if (program.constants[index] == constant) {
-        return (uint32_t)index;
-      }
-    }
-    program.constants.push_back(constant);
-    return program.constants.size() - 1;
+  void pushUint32(JSProgram &program, uint32_t value) {
+    JSBytecode::pushVarint(program.codes, value);
   }
 
-  void pushUint32(JSProgram &program, uint32_t value) {
+  void pushAddress(JSProgram &program, size_t address) {
     auto offset = program.codes.size();
-    program.codes.push_back(0);
-    program.codes.push_back(0);
-    *(uint32_t *)(program.codes.data() + offset) = value;
+    JSBytecode::pushFixed(program.codes, 0);
+    setAddress(program, offset, address);
   }
 
-  void pushAddress(JSProgram &program, uint64_t value) {
-    auto offset = program.codes.size();
-    program.codes.push_back(0);
-    program.codes.push_back(0);
-    program.codes.push_back(0);
-    program.codes.push_back(0);
-    *(uint64_t *)(program.codes.data() + offset) = value;
+  void setAddress(JSProgram &program, size_t offset, size_t address) {
+    JSBytecode::setAddress(program.codes, offset, address);
   }
 
-  void pushString(JSProgram &program, const std::wstring &value) {
-    pushUint32(program, resolveConstant(program, value));
+  void pushConstant(JSProgram &program, JSConstantPool &pool,
+                    const std::wstring &value) {
+    pushUint32(program, pool.resolve(value));
+  }
+
+  void pushIdentifier(JSProgram &program, const std::wstring &value) {
+    pushConstant(program, program.identifiers, value);
+  }
+
+  // NaN and Infinity have no binding of their own
+  void pushLoad(JSProgram &program, const std::wstring &name) {
+    if (name == L"NaN") {
+      pushOperator(program, JS_OPERATOR::LOAD_NAN);
+    } else if (name == L"Infinity") {
+      pushOperator(program, JS_OPERATOR::LOAD_INFINITY);
+    } else {
+      pushOperator(program, JS_OPERATOR::LOAD);
+      pushIdentifier(program, name);
+    }
   }
 
-  void pushUint16(JSProgram &program, uint16_t value) {
-    program.codes.push_back(value);
+  void pushString(JSProgram &program, const std::wstring &value) {
+    auto index = program.strings.resolve(value);
+    if (index == program.stringValues.size()) {
+      program.stringValues.push_back(std::make_shared<JSString::Rope>(value));
+    }
+    pushUint32(program, index);
   }
 
   void pushNumber(JSProgram &program, double value) {
-    auto offset = program.codes.size();
-    program.codes.push_back(0);
-    program.codes.push_back(0);
-    program.codes.push_back(0);
-    program.codes.push_back(0);
-    *(double *)(program.codes.data() + offset) = value;
+    JSBytecode::pushNumber(program.codes, value);
   }
 
   void pushOperator(JSProgram &program, const JS_OPERATOR &opt) {
-    pushUint16(program, (uint16_t)opt);
+    program.codes.push_back((uint8_t)opt);
   }
 
   JSNode *createError(const std::wstring &message, const JSLocation &loc) {
@@ -99,7 +105,7 @@ private:
 
   std::wstring pushBreakFrame(JSProgram &program) {
     pushOperator(program, JS_OPERATOR::BREAK_LABEL_BEGIN);
-    pushString(program, _label);
+    pushIdentifier(program, _label);
     pushOperator(program, JS_OPERATOR::SET_LABELE_ADDRESS);
     _breaks.push_back({
         .label = _label,
@@ -112,7 +118,7 @@ private:
   }
   void pushContinueFrame(JSProgram &program, const std::wstring &label) {
     pushOperator(program, JS_OPERATOR::CONTINUE_LABEL_BEGIN);
-    pushString(program, label);
+    pushIdentifier(program, label);
     pushOperator(program, JS_OPERATOR::SET_LABELE_ADDRESS);
     _breaks.push_back({
         .label = label,
@@ -121,9 +127,12 @@ private:
     pushAddress(program, 0);
   }
 
+  JSNode *resolveLazyFunction(const std::wstring &source, JSNode *node,
+                              JSProgram &program);
+
   void popLabelFrame(JSProgram &program, size_t addr,
                      const std::wstring &label = L"") {
-    *(size_t *)(program.codes.data() + _breaks.rbegin()->address) = addr;
+    setAddress(program, _breaks.rbegin()->address, addr);
     _breaks.pop_back();
     _label = label;
     pushOperator(program, JS_OPERATOR::LABEL_END);
@@ -134,11 +143,18 @@ public:
 
   virtual ~JSCodeGenerator() {}
 
+  // function bodies are left as LAZY stubs and generated on first call
+  void setLazy(bool lazy) { _lazy = lazy; }
+
+  bool isLazy() const { return _lazy; }
+
   JSNode *resolveNode(const std::wstring &source, JSNode *node,
                       JSProgram &program);
 
+  // open is false when the declarations go into the scope already on top
   std::unordered_map<JSNode *, size_t>
-  beginScope(const std::wstring &source, JSNode *node, JSProgram &program);
+  beginScope(const std::wstring &source, JSNode *node, JSProgram &program,
+             bool open = true);
 
   JSNode *endScope(const std::wstring &source, JSNode *node, JSProgram &program,
                    std::unordered_map<JSNode *, size_t> &ctx);
@@ -163,6 +179,11 @@ public:
 
   JSNode *resolve(const std::wstring &source, JSNode *node, JSProgram &program);
 
+  // appends one chunk of a program read in pieces; every chunk after the
+  // first declares into the scope the first one left open
+  JSNode *resolveChunk(const std::wstring &source, JSNode *node,
+                       JSProgram &program, bool first);
+
   JSNode *resolveRegexLiteral(const std::wstring &source, JSNode *node,
                               JSProgram &program);
 
@@ -87,6 +87,7 @@ enum class JS_OPERATOR {
   UPLUS,
   UNEG,
   ADD,
+  CONCAT,
   SUB,
   DIV,
   MUL,
@@ -128,4 +129,7 @@ enum class JS_OPERATOR {
   EXPORT,
   EXPORT_ALL,
   ASSERT,
+  LAZY,
+  LOAD_NAN,
+  LOAD_INFINITY,
 };
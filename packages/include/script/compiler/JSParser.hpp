@@ -4,10 +4,12 @@
 #include "../util/JSAllocator.hpp"
 #include "../util/JSLocation.hpp"
 #include "../util/JSON.hpp"
+#include "JSTokenizer.hpp"
 #include <algorithm>
 #include <array>
 #include <set>
 #include <string>
+#include <string_view>
 #include <vector>
 
 enum class JS_ACCESSOR_TYPE { GET, SET };
@@ -1810,6 +1812,13 @@ private:
   JSCompileScope *_scope = nullptr;
   JSAllocator *_allocator{};
   JS_EVAL_TYPE _type{JS_EVAL_TYPE::PROGRAM};
+  std::vector<size_t> _lines;
+  std::vector<size_t> _carriages;
+  const wchar_t *_indexed{};
+  size_t _indexedSize{};
+  size_t _firstLine{1};
+  JSTokenizer _tokenizer;
+  std::vector<std::pair<JSCompileScope *, std::wstring>> _refs;
 
 private:
   JSCompileScope *pushScope(const JS_COMPILE_SCOPE_TYPE &type, JSNode *node) {
@@ -1820,6 +1829,33 @@ private:
 
   void popScope() { _scope = _scope->parent; }
 
+  void addRef(const std::wstring &name) {
+    if (_scope->refs.insert(name).second) {
+      _refs.push_back({_scope, name});
+    }
+  }
+
+  // a speculative parse only appends to the current scope, so undoing it
+  // truncates the declarations and replays the ref log back to the
+  // checkpoint instead of copying the scope up front
+  std::pair<size_t, size_t> checkpoint() const {
+    return {_scope ? _scope->declarations.size() : 0, _refs.size()};
+  }
+
+  void rollback(const std::pair<size_t, size_t> &checkpoint) {
+    if (!_scope) {
+      return;
+    }
+    _scope->declarations.resize(checkpoint.first);
+    while (_refs.size() > checkpoint.second) {
+      auto &[scope, name] = _refs.back();
+      if (scope == _scope) {
+        _scope->refs.erase(name);
+      }
+      _refs.pop_back();
+    }
+  }
+
   JSNode *resolveDeclarator(const JS_DECLARATION_TYPE &type,
                             const std::wstring &source, JSNode *identifier,
                             JSNode *declaration);
@@ -1840,61 +1876,13 @@ private:
   }
 
 private:
-  bool isLineTerminator(wchar_t c) {
-    if (c == 0xa) {
-      return true;
-    }
-    if (c == 0xd) {
-      return true;
-    }
-    if (c == 0x2028) {
-      return true;
-    }
-    if (c == 0x2029) {
-      return true;
-    }
-    return false;
-  }
-
-  bool isWhiteSpace(wchar_t c) {
+  bool isLineTerminator(wchar_t c) { return JSTokenizer::isLineTerminator(c); }
 
-    if (c == 0x9) {
-      return true;
-    }
-    if (c == 0xb) {
-      return true;
-    }
-    if (c == 0xc) {
-      return true;
-    }
-    if (c == 0x20) {
-      return true;
-    }
-    if (c == 0xa0) {
-      return true;
-    }
-    if (c == 0xfeff) {
-      return true;
-    }
-    return false;
-  }
+  bool isWhiteSpace(wchar_t c) { return JSTokenizer::isWhiteSpace(c); }
 
   bool isKeyword(const std::wstring &source, const JSLocation &location) {
-    static std::array keywords = {
-        L"break",      L"case",     L"catch",   L"class",  L"const",
-        L"continue",   L"debugger", L"default", L"delete", L"do",
-        L"else",       L"export",   L"extends", L"false",  L"finally",
-        L"for",        L"function", L"if",      L"import", L"in",
-        L"instanceof", L"new",      L"null",    L"return", L"super",
-        L"switch",     L"this",     L"throw",   L"true",   L"try",
-        L"typeof",     L"var",      L"void",    L"while",  L"with",
-        L"let",        L"static"};
-    for (auto &keyword : keywords) {
-      if (location.is(source, keyword)) {
-        return true;
-      }
-    }
-    return false;
+    return JSTokenizer::isKeyword(source.c_str() + location.start.offset,
+                                  location.end.offset - location.start.offset);
   }
 
 private:
@@ -1951,35 +1939,45 @@ private:
                        node->location.start);
   }
 
-  JSLocation getLocation(const std::wstring &source, const JSPosition &start,
-                         const JSPosition &end) {
-    JSLocation loc;
-    loc.start = {
-        .funcname = L"neo.compile", .line = 1, .column = 1, .offset = 0};
-    while (loc.start.offset < start.offset) {
-      if (isLineTerminator(source[loc.start.offset])) {
-        if (source[loc.start.offset] != '\r') {
-          loc.start.column = 1;
-          loc.start.line++;
-        }
-      } else {
-        loc.start.column++;
+  void indexLines(const std::wstring &source) {
+    _lines.clear();
+    _carriages.clear();
+    _lines.push_back(0);
+    for (size_t offset = 0; offset < source.size(); offset++) {
+      auto c = source[offset];
+      if (c == '\r') {
+        _carriages.push_back(offset);
+      } else if (isLineTerminator(c)) {
+        _lines.push_back(offset + 1);
       }
-      loc.start.offset++;
     }
+    _indexed = source.data();
+    _indexedSize = source.size();
+  }
 
-    loc.end = {.funcname = L"neo.compile", .line = 1, .column = 1, .offset = 0};
-    while (loc.end.offset < end.offset) {
-      if (isLineTerminator(source[loc.end.offset])) {
-        if (source[loc.end.offset] != '\r') {
-          loc.end.column = 1;
-          loc.end.line++;
-        }
-      } else {
-        loc.end.column++;
-      }
-      loc.end.offset++;
+  // a line terminator starts a new line at column 1, except '\r' which
+  // neither starts a line nor advances the column
+  JSPosition getPosition(size_t offset) const {
+    auto line = std::upper_bound(_lines.begin(), _lines.end(), offset);
+    auto start = *(line - 1);
+    auto carriages =
+        std::lower_bound(_carriages.begin(), _carriages.end(), offset) -
+        std::lower_bound(_carriages.begin(), _carriages.end(), start);
+    return {
+        .line = (size_t)(line - _lines.begin()) + _firstLine - 1,
+        .column = offset - start - carriages + 1,
+        .offset = offset,
+    };
+  }
+
+  JSLocation getLocation(const std::wstring &source, const JSPosition &start,
+                         const JSPosition &end) {
+    if (_indexed != source.data() || _indexedSize != source.size()) {
+      indexLines(source);
     }
+    JSLocation loc;
+    loc.start = getPosition(start.offset);
+    loc.end = getPosition(end.offset);
     return loc;
   }
 
@@ -2005,50 +2003,44 @@ private:
   }
 
 private:
-  bool checkIdentifier(const std::vector<std::wstring> &identifiers,
-                       const std::wstring &source, JSPosition &position,
-                       JSNode **ptoken = nullptr) {
-    auto current = position;
-    auto token = readIdentifyLiteral(source, current);
-    if (!token) {
+  bool checkToken(const JSTokenizer::KIND &kind,
+                  std::initializer_list<std::wstring_view> expected,
+                  const std::wstring &source, JSPosition &position,
+                  JSNode **ptoken) {
+    auto length = kind == JSTokenizer::KIND::SYMBOL
+                      ? _tokenizer.readSymbol(source, position.offset)
+                      : _tokenizer.readIdentifier(source, position.offset);
+    if (!length) {
       return false;
     }
-    for (auto &identifier : identifiers) {
-      if (token->location.is(source, identifier)) {
-        position = current;
+    for (auto &item : expected) {
+      if (item.size() == length &&
+          source.compare(position.offset, length, item.data(), length) == 0) {
         if (ptoken) {
-          *ptoken = token;
+          *ptoken = kind == JSTokenizer::KIND::SYMBOL
+                        ? readSymbolToken(source, position)
+                        : readIdentifyLiteral(source, position);
         } else {
-          _allocator->dispose(token);
+          position.offset += length;
         }
         return true;
       }
     }
-    _allocator->dispose(token);
     return false;
   }
-  
-  bool checkSymbol(const std::vector<std::wstring> &symbols,
+
+  bool checkIdentifier(std::initializer_list<std::wstring_view> identifiers,
+                       const std::wstring &source, JSPosition &position,
+                       JSNode **ptoken = nullptr) {
+    return checkToken(JSTokenizer::KIND::IDENTIFIER, identifiers, source,
+                      position, ptoken);
+  }
+
+  bool checkSymbol(std::initializer_list<std::wstring_view> symbols,
                    const std::wstring &source, JSPosition &position,
                    JSNode **ptoken = nullptr) {
-    auto current = position;
-    auto token = readSymbolToken(source, current);
-    if (!token) {
-      return false;
-    }
-    for (auto &symbol : symbols) {
-      if (token->location.is(source, symbol)) {
-        position = current;
-        if (ptoken) {
-          *ptoken = token;
-        } else {
-          _allocator->dispose(token);
-        }
-        return true;
-      }
-    }
-    _allocator->dispose(token);
-    return false;
+    return checkToken(JSTokenizer::KIND::SYMBOL, symbols, source, position,
+                      ptoken);
   }
 
   JSNode *readSymbolToken(const std::wstring &source, JSPosition &position);
@@ -2313,13 +2305,36 @@ public:
   virtual JSNode *parse(const std::wstring &source,
                         const JS_EVAL_TYPE &type = JS_EVAL_TYPE::PROGRAM) {
     this->_type = type;
+    indexLines(source);
+    _tokenizer.reset(source);
+    _refs.clear();
     JSPosition pos = {};
     auto node = readProgram(source, pos);
     resolveBinding(source, node);
     return node;
   }
 
+  // re-reads the function or arrow at offset of a source parsed before;
+  // closure names the variables it captures from the enclosing code
+  virtual JSNode *
+  parseFunction(const std::wstring &source, size_t offset, bool arrow,
+                const std::vector<std::wstring> &closure,
+                const JS_EVAL_TYPE &type = JS_EVAL_TYPE::PROGRAM);
+
+  // parses the next piece of a source read in chunks; declared names the
+  // top-level variables of the chunks before it and line is the line the
+  // chunk starts on
+  virtual JSNode *
+  parseChunk(const std::wstring &source,
+             const std::set<std::wstring> &declared, size_t line,
+             const JS_EVAL_TYPE &type = JS_EVAL_TYPE::PROGRAM);
+
   JSParser(JSAllocator *allocator) : _allocator(allocator) {}
 
+  JSAllocator *getAllocator() const { return _allocator; }
+
+  // nodes and compile scopes of the following parses come from allocator
+  void setAllocator(JSAllocator *allocator) { _allocator = allocator; }
+
   virtual ~JSParser() {}
 };
\ No newline at end of file
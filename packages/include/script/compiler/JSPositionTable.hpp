@@ -0,0 +1,53 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// pc -> source position map for call sites, stored as varint deltas
+// (pc delta, zigzag line delta, column) with a checkpoint every
+// CHECKPOINT_INTERVAL entries so lookups binary search and then decode at
+// most one interval. Entries must be pushed in non-decreasing pc order.
+class JSPositionTable {
+public:
+  struct Entry {
+    size_t pc;
+    size_t line;
+    size_t column;
+  };
+
+  static constexpr size_t CHECKPOINT_INTERVAL = 16;
+
+private:
+  struct Checkpoint {
+    size_t offset;
+    size_t pc;
+    size_t line;
+    size_t first;
+  };
+
+  std::vector<uint8_t> _data;
+  std::vector<Checkpoint> _checkpoints;
+  size_t _size{};
+  size_t _pc{};
+  size_t _line{};
+
+  void writeVarint(uint64_t value);
+
+  static uint64_t readVarint(const uint8_t *&data);
+
+public:
+  void push(size_t pc, size_t line, size_t column);
+
+  bool find(size_t pc, Entry &entry) const;
+
+  std::vector<Entry> getEntries() const;
+
+  // drops every entry at or after pc
+  void truncate(size_t pc);
+
+  inline size_t size() const { return _size; }
+
+  inline size_t getByteSize() const {
+    return _data.size() + _checkpoints.size() * sizeof(Checkpoint);
+  }
+};
@@ -1,18 +1,59 @@
 #pragma once
-#include "../engine/JSStackFrame.hpp"
+#include "../engine/JSString.hpp"
+#include "../util/BigInt.hpp"
 #include "JSParser.hpp"
+#include "JSPositionTable.hpp"
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+// a function whose body is generated on its first call; offset is where
+// the parser re-reads it and closure lists the names it captures
+struct JSLazyFunction {
+  size_t offset;
+  bool arrow;
+  std::vector<std::wstring> closure;
+};
+
+// interned constants of one kind; the index is the operand kept in code
+struct JSConstantPool {
+  std::vector<std::wstring> values;
+  std::unordered_map<std::wstring, uint32_t> indices;
+
+  uint32_t resolve(const std::wstring &value) {
+    auto [it, inserted] = indices.try_emplace(value, (uint32_t)values.size());
+    if (inserted) {
+      values.push_back(value);
+    }
+    return it->second;
+  }
+
+  const std::wstring &operator[](size_t index) const { return values[index]; }
+
+  size_t size() const { return values.size(); }
+};
+
 struct JSProgram {
   std::wstring filename;
-  std::vector<std::wstring> constants;
-  std::vector<uint16_t> codes;
-  std::unordered_map<size_t, JSStackFrame> stacks;
+  // variable, label, module and export names and directives
+  JSConstantPool identifiers;
+  JSConstantPool strings;
+  // shared by every STR that pushes the constant, so running one copies
+  // no characters
+  std::vector<std::shared_ptr<JSString::Rope>> stringValues;
+  JSConstantPool regexes;
+  JSConstantPool bigintLiterals;
+  std::vector<BigInt<>> bigints;
+  std::vector<uint8_t> codes;
+  JSPositionTable positions;
   JSErrorNode *error{};
   JSAllocator *allocator{};
+  std::vector<JSLazyFunction> lazyFunctions;
+  size_t lazyPending{};
+  std::wstring source;
+  JS_EVAL_TYPE type{JS_EVAL_TYPE::PROGRAM};
   JSProgram() {}
   virtual ~JSProgram() {
     if (error) {
@@ -0,0 +1,100 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum JS_CHAR_CLASS : uint8_t {
+  JS_CHAR_WHITESPACE = 1 << 0,
+  JS_CHAR_LINE_TERMINATOR = 1 << 1,
+  JS_CHAR_IDENTIFIER_START = 1 << 2,
+  JS_CHAR_IDENTIFIER_PART = 1 << 3,
+};
+
+inline constexpr std::array<uint8_t, 128> JS_CHAR_CLASSES = [] {
+  std::array<uint8_t, 128> classes{};
+  for (auto c : {'\t', '\v', '\f', ' '}) {
+    classes[c] |= JS_CHAR_WHITESPACE;
+  }
+  classes['\n'] |= JS_CHAR_LINE_TERMINATOR;
+  classes['\r'] |= JS_CHAR_LINE_TERMINATOR;
+  for (size_t c = 0; c < 128; c++) {
+    if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '$' ||
+        c == '_') {
+      classes[c] |= JS_CHAR_IDENTIFIER_START | JS_CHAR_IDENTIFIER_PART;
+    }
+    if (c >= '0' && c <= '9') {
+      classes[c] |= JS_CHAR_IDENTIFIER_PART;
+    }
+  }
+  return classes;
+}();
+
+// lexes tokens on demand and remembers them by (kind, offset), so the
+// parser can backtrack to a saved position and read the same token again
+// without re-scanning the source
+class JSTokenizer {
+public:
+  enum class KIND { SYMBOL = 0, IDENTIFIER, STRING, COUNT };
+
+private:
+  // per kind and offset: 0 = not lexed yet, otherwise token length + 1
+  std::vector<uint32_t> _tokens[(size_t)KIND::COUNT];
+  const wchar_t *_source{};
+  size_t _size{};
+
+private:
+  size_t scanSymbol(const std::wstring &source, size_t offset) const;
+
+  size_t scanIdentifier(const std::wstring &source, size_t offset) const;
+
+  size_t scanString(const std::wstring &source, size_t offset) const;
+
+  size_t read(const KIND &kind, const std::wstring &source, size_t offset);
+
+public:
+  static constexpr size_t UNTERMINATED = (size_t)-1;
+
+  static bool isWhiteSpace(wchar_t c) {
+    if ((uint32_t)c < JS_CHAR_CLASSES.size()) {
+      return JS_CHAR_CLASSES[c] & JS_CHAR_WHITESPACE;
+    }
+    return c == 0xa0 || c == 0xfeff;
+  }
+
+  static bool isLineTerminator(wchar_t c) {
+    if ((uint32_t)c < JS_CHAR_CLASSES.size()) {
+      return JS_CHAR_CLASSES[c] & JS_CHAR_LINE_TERMINATOR;
+    }
+    return c == 0x2028 || c == 0x2029;
+  }
+
+  static bool isIdentifierStart(wchar_t c) {
+    return (uint32_t)c < JS_CHAR_CLASSES.size() &&
+           (JS_CHAR_CLASSES[c] & JS_CHAR_IDENTIFIER_START);
+  }
+
+  static bool isIdentifierPart(wchar_t c) {
+    return (uint32_t)c < JS_CHAR_CLASSES.size() &&
+           (JS_CHAR_CLASSES[c] & JS_CHAR_IDENTIFIER_PART);
+  }
+
+  static bool isKeyword(const wchar_t *name, size_t length);
+
+  void reset(const std::wstring &source);
+
+  // each returns the length of the token at offset, 0 if there is none
+  size_t readSymbol(const std::wstring &source, size_t offset) {
+    return read(KIND::SYMBOL, source, offset);
+  }
+
+  size_t readIdentifier(const std::wstring &source, size_t offset) {
+    return read(KIND::IDENTIFIER, source, offset);
+  }
+
+  // UNTERMINATED if the string runs into the end of the source
+  size_t readString(const std::wstring &source, size_t offset) {
+    return read(KIND::STRING, source, offset);
+  }
+};
@@ -4,6 +4,9 @@
 #include <cstddef>
 #include <unordered_map>
 class JSArray : public JSObject {
+public:
+  static constexpr uint32_t MASK = JSObject::MASK | (1u << 5);
+
 private:
   std::unordered_map<size_t, JSAtom *> _items;
 
@@ -4,14 +4,20 @@
 #include "script/engine/JSValue.hpp"
 #include "script/util/JSAllocator.hpp"
 class JSArrayType : public JSObjectType {
+public:
+  static constexpr uint32_t MASK = JSObjectType::MASK | (1u << 5);
+
+private:
+  bool getIndex(JSContext *ctx, JSValue *name, size_t &index) const;
+
 public:
   JSArrayType(JSAllocator *allocator);
 
 public:
   JSValue *toString(JSContext *ctx, JSValue *value) const override;
 
-  JSValue *getField(JSContext *ctx, JSValue *array,
-                    JSValue *name) const override;
+  JSValue *getField(JSContext *ctx, JSValue *array, JSValue *name,
+                    JSValue *self = nullptr) const override;
                     
   JSValue *setField(JSContext *ctx, JSValue *array, JSValue *name,
                     JSValue *value) const override;
@@ -2,6 +2,7 @@
 #include "../util/JSAllocator.hpp"
 #include "JSType.hpp"
 #include "script/util/JSRef.hpp"
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 class JSAtom;
@@ -10,6 +11,12 @@ private:
   JSType *_type;
   std::unordered_map<std::wstring, JSAtom *> _metadata;
 
+protected:
+  uint32_t _mask{};
+
+public:
+  static constexpr uint32_t MASK = 0;
+
 public:
   JSBase(JSAllocator *allocator, JSType *type);
 
@@ -17,10 +24,15 @@ public:
 
   inline const JSType *getType() const { return _type; }
 
-  template <class T> T *cast() { return dynamic_cast<T *>(this); }
+  template <class T> T *cast() {
+    if ((_mask & T::MASK) != T::MASK) {
+      return nullptr;
+    }
+    return static_cast<T *>(this);
+  }
 
   template <class T> bool isTypeof() const {
-    return getType()->cast<T>() != nullptr;
+    return (_type->getMask() & T::MASK) == T::MASK;
   }
   
   inline const std::unordered_map<std::wstring, JSAtom *> &getMetadata() const {
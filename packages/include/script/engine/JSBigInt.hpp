@@ -2,6 +2,9 @@
 #include "JSBase.hpp"
 #include "script/util/BigInt.hpp"
 class JSBigInt : public JSBase {
+public:
+  static constexpr uint32_t MASK = JSBase::MASK | (1u << 12);
+
 private:
   BigInt<> _value;
 
@@ -3,8 +3,11 @@
 #include "script/engine/JSType.hpp"
 #include "script/engine/JSValue.hpp"
 class JSBigIntType : public JSType {
-
 public:
+  static constexpr uint32_t MASK = JSType::MASK | (1u << 11);
+
+  static constexpr size_t MAX_BIT_LENGTH = 1 << 30;
+
   JSBigIntType(JSAllocator *allocator);
 
 public:
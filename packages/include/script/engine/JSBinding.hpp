@@ -0,0 +1,281 @@
+#pragma once
+#include "JSBooleanType.hpp"
+#include "JSContext.hpp"
+#include "JSInfinity.hpp"
+#include "JSInfinityType.hpp"
+#include "JSNaNType.hpp"
+#include "JSNumber.hpp"
+#include "JSNumberType.hpp"
+#include "JSObject.hpp"
+#include "JSObjectType.hpp"
+#include "JSStringType.hpp"
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+// JSConverter<T> maps a C++ parameter or return type onto script values:
+//  coerce: script value -> value of the matching script type, or exception
+//  get:    coerced script value -> T
+//  create: T -> script value
+// coerce returns its input untouched when the type already matches, so
+// exact matches cost a single mask test and JSValue * costs nothing.
+template <class T, class = void> struct JSConverter {
+  static_assert(sizeof(T) == 0, "type has no JSConverter specialization");
+};
+
+template <> struct JSConverter<JSValue *> {
+  static JSValue *coerce(JSContext *ctx, JSValue *value) { return value; }
+
+  static JSValue *get(JSContext *ctx, JSValue *value) { return value; }
+
+  static JSValue *create(JSContext *ctx, JSValue *value) { return value; }
+};
+
+template <> struct JSConverter<bool> {
+  static JSValue *coerce(JSContext *ctx, JSValue *value) {
+    if (value->isTypeof<JSBooleanType>()) {
+      return value;
+    }
+    return ctx->toBoolean(value);
+  }
+
+  static bool get(JSContext *ctx, JSValue *value) {
+    return ctx->checkedBoolean(value);
+  }
+
+  static JSValue *create(JSContext *ctx, bool value) {
+    return ctx->createBoolean(value);
+  }
+};
+
+template <class T>
+struct JSConverter<T, std::enable_if_t<std::is_arithmetic_v<T> &&
+                                       !std::is_same_v<T, bool>>> {
+  static JSValue *coerce(JSContext *ctx, JSValue *value) {
+    if (value->isTypeof<JSNumberType>()) {
+      return value;
+    }
+    return ctx->toNumber(value);
+  }
+
+  static T get(JSContext *ctx, JSValue *value) {
+    if (value->isTypeof<JSNaNType>()) {
+      if constexpr (std::is_floating_point_v<T>) {
+        return std::numeric_limits<T>::quiet_NaN();
+      } else {
+        return 0;
+      }
+    }
+    if (value->isTypeof<JSInfinityType>()) {
+      if constexpr (std::is_floating_point_v<T>) {
+        auto negative = value->getData()->cast<JSInfinity>()->isNegative();
+        return negative ? -std::numeric_limits<T>::infinity()
+                        : std::numeric_limits<T>::infinity();
+      } else {
+        return 0;
+      }
+    }
+    auto number = value->getData()->cast<JSNumber>();
+    if constexpr (std::is_floating_point_v<T>) {
+      return (T)number->getValue();
+    } else {
+      if constexpr (std::is_same_v<T, int32_t>) {
+        if (number->isInteger()) {
+          return number->getInteger();
+        }
+      }
+      auto val = std::trunc(number->getValue());
+      if (val <= (double)std::numeric_limits<T>::lowest()) {
+        return std::numeric_limits<T>::lowest();
+      }
+      if (val >= (double)std::numeric_limits<T>::max()) {
+        return std::numeric_limits<T>::max();
+      }
+      return (T)val;
+    }
+  }
+
+  static JSValue *create(JSContext *ctx, T value) {
+    if constexpr (std::is_floating_point_v<T>) {
+      if (std::isnan(value)) {
+        return ctx->createNaN();
+      }
+      if (std::isinf(value)) {
+        return ctx->createInfinity(value < 0);
+      }
+      return ctx->createNumber((double)value);
+    } else {
+      if constexpr (sizeof(T) < sizeof(int32_t) ||
+                    std::is_same_v<T, int32_t>) {
+        return ctx->createInteger((int32_t)value);
+      }
+      return ctx->createNumber((double)value);
+    }
+  }
+};
+
+template <> struct JSConverter<std::wstring> {
+  static JSValue *coerce(JSContext *ctx, JSValue *value) {
+    if (value->isTypeof<JSStringType>()) {
+      return value;
+    }
+    return ctx->toString(value);
+  }
+
+  static const std::wstring &get(JSContext *ctx, JSValue *value) {
+    return ctx->checkedString(value);
+  }
+
+  static JSValue *create(JSContext *ctx, const std::wstring &value) {
+    return ctx->createString(value);
+  }
+};
+
+// instances of a class bound through JSClassBinding<C> keep their C++ object
+// in the opaque slot of the script object, tagged with JSClassTag<C>
+template <class C> struct JSClassTag {
+  static inline const char value = 0;
+};
+
+template <class C>
+struct JSConverter<C *, std::enable_if_t<std::is_class_v<C>>> {
+  static JSValue *coerce(JSContext *ctx, JSValue *value) {
+    auto object = value->getData()->cast<JSObject>();
+    if (!object || !object->getOpaque(&JSClassTag<C>::value)) {
+      return ctx->createException(JSException::TYPE::TYPE,
+                                  L"Illegal invocation");
+    }
+    return value;
+  }
+
+  static C *get(JSContext *ctx, JSValue *value) {
+    return static_cast<C *>(
+        value->getData()->cast<JSObject>()->getOpaque(&JSClassTag<C>::value));
+  }
+};
+
+template <class T>
+using JSConverterOf = JSConverter<std::remove_cvref_t<T>>;
+
+template <class... Args> class JSBindingArguments {
+private:
+  using Values = std::array<JSValue *, sizeof...(Args)>;
+
+  template <class T>
+  static bool coerce(JSContext *ctx, JSArguments args, size_t index,
+                     JSValue *&value) {
+    value = index < args.size() ? args[index] : ctx->createUndefined();
+    value = JSConverterOf<T>::coerce(ctx, value);
+    return !ctx->isException(value);
+  }
+
+  template <class R, class Fn, size_t... I>
+  static JSValue *call(JSContext *ctx, JSArguments args, const Fn &fn,
+                       std::index_sequence<I...>) {
+    Values values{};
+    if (!(coerce<Args>(ctx, args, I, values[I]) && ...)) {
+      for (auto value : values) {
+        CHECK(ctx, value);
+      }
+    }
+    if constexpr (std::is_void_v<R>) {
+      fn(JSConverterOf<Args>::get(ctx, values[I])...);
+      return ctx->createUndefined();
+    } else {
+      return JSConverterOf<R>::create(
+          ctx, fn(JSConverterOf<Args>::get(ctx, values[I])...));
+    }
+  }
+
+public:
+  template <class R, class Fn>
+  static JSValue *call(JSContext *ctx, JSArguments args, const Fn &fn) {
+    return call<R>(ctx, args, fn, std::index_sequence_for<Args...>{});
+  }
+};
+
+template <auto F> struct JSBinding;
+
+template <class R, class... Args, R (*F)(Args...)> struct JSBinding<F> {
+  static JSValue *invoke(JSContext *ctx, JSValue *self, JSArguments args) {
+    return JSBindingArguments<Args...>::template call<R>(
+        ctx, args, [](auto &&...values) -> R {
+          return F(std::forward<decltype(values)>(values)...);
+        });
+  }
+};
+
+template <class C, class R, class... Args, R (C::*F)(Args...)>
+struct JSBinding<F> {
+  static JSValue *invoke(JSContext *ctx, JSValue *self, JSArguments args) {
+    auto object = JSConverter<C *>::coerce(ctx, self);
+    CHECK(ctx, object);
+    auto instance = JSConverter<C *>::get(ctx, object);
+    return JSBindingArguments<Args...>::template call<R>(
+        ctx, args, [instance](auto &&...values) -> R {
+          return (instance->*F)(std::forward<decltype(values)>(values)...);
+        });
+  }
+};
+
+template <class C, class R, class... Args, R (C::*F)(Args...) const>
+struct JSBinding<F> {
+  static JSValue *invoke(JSContext *ctx, JSValue *self, JSArguments args) {
+    auto object = JSConverter<C *>::coerce(ctx, self);
+    CHECK(ctx, object);
+    const C *instance = JSConverter<C *>::get(ctx, object);
+    return JSBindingArguments<Args...>::template call<R>(
+        ctx, args, [instance](auto &&...values) -> R {
+          return (instance->*F)(std::forward<decltype(values)>(values)...);
+        });
+  }
+};
+
+template <auto F> JSValue *bind(JSContext *ctx, const std::wstring &name) {
+  return ctx->createNativeFunction(&JSBinding<F>::invoke, name);
+}
+
+// exposes C as a script class: `new name(...)` constructs a C from Args,
+// methods are installed on the constructor's prototype
+template <class C, class... Args> class JSClassBinding {
+private:
+  JSContext *_ctx;
+  JSValue *_constructor;
+
+  static JSValue *construct(JSContext *ctx, JSValue *self, JSArguments args) {
+    auto object = self->getData()->cast<JSObject>();
+    if (!object || object->getOpaque(&JSClassTag<C>::value)) {
+      return ctx->createException(
+          JSException::TYPE::TYPE,
+          L"Class constructor cannot be invoked without 'new'");
+    }
+    return JSBindingArguments<Args...>::template call<void>(
+        ctx, args, [object](auto &&...values) {
+          object->setOpaque(&JSClassTag<C>::value,
+                            std::make_shared<C>(
+                                std::forward<decltype(values)>(values)...));
+        });
+  }
+
+public:
+  JSClassBinding(JSContext *ctx, const std::wstring &name)
+      : _ctx(ctx), _constructor(ctx->createNativeFunction(&construct, name)) {}
+
+  inline JSValue *getConstructor() const { return _constructor; }
+
+  JSValue *getPrototype() const {
+    return _ctx->getField(_constructor, _ctx->createString(L"prototype"));
+  }
+
+  template <auto F> JSValue *method(const std::wstring &name) {
+    auto prototype = getPrototype();
+    CHECK(_ctx, prototype);
+    return _ctx->setField(prototype, _ctx->createString(name),
+                          bind<F>(_ctx, name));
+  }
+};
@@ -1,6 +1,9 @@
 #pragma once
 #include "JSBase.hpp"
 class JSBoolean : public JSBase {
+public:
+  static constexpr uint32_t MASK = JSBase::MASK | (1u << 11);
+
 private:
   bool _value;
 
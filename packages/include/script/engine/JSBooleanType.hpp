@@ -2,6 +2,8 @@
 #include "JSType.hpp"
 class JSBooleanType : public JSType {
 public:
+  static constexpr uint32_t MASK = JSType::MASK | (1u << 10);
+
   JSBooleanType(JSAllocator *allocator);
 
 public:
@@ -6,11 +6,20 @@
 #include "script/engine/JSAtom.hpp"
 #include "script/engine/JSValue.hpp"
 #include <functional>
+#include <span>
 class JSContext;
-using JS_NATIVE =
-    std::function<JSValue *(JSContext *, JSValue *, std::vector<JSValue *>)>;
+
+// view over the caller's argument slots, valid for the duration of the call
+using JSArguments = std::span<JSValue *const>;
+
+using JS_NATIVE = std::function<JSValue *(JSContext *, JSValue *, JSArguments)>;
+
+using JS_NATIVE_ENTRY = JSValue *(*)(JSContext *, JSValue *, JSArguments);
 
 class JSCallable : public JSObject {
+public:
+  static constexpr uint32_t MASK = JSObject::MASK | (1u << 1);
+
 private:
   std::unordered_map<std::wstring, JSAtom *> _closure;
 
@@ -18,6 +27,8 @@ private:
 
   bool _globalContext;
 
+  bool _lazy;
+
   JSAtom *_self;
 
   JSAtom *_clazz;
@@ -34,6 +45,10 @@ public:
 
   inline void setGlobalContext(bool context) { _globalContext = context; }
 
+  inline bool isLazy() const { return _lazy; }
+
+  inline void setLazy(bool lazy) { _lazy = lazy; }
+
   inline const std::wstring &getName() const { return _name; }
 
   inline void setName(const std::wstring &name) { _name = name; }
@@ -1,16 +1,21 @@
 #pragma once
+#include "script/engine/JSCallable.hpp"
 #include "script/engine/JSObjectType.hpp"
 #include "script/engine/JSType.hpp"
 class JSCallableType : public JSObjectType {
 public:
+  static constexpr uint32_t MASK = JSObjectType::MASK | (1u << 1);
+
   JSCallableType(JSAllocator *allocator);
 
 public:
   const wchar_t *getTypeName() const override;
 
+  JSValue *materialize(JSContext *ctx, JSAtom *atom) const override;
+
 public:
   virtual JSValue *call(JSContext *ctx, JSValue *func, JSValue *self,
-                        std::vector<JSValue *> args) const = 0;
+                        JSArguments args) const = 0;
 
   JSValue *setSelf(JSContext *ctx, JSValue *value, JSValue *self) const;
 
@@ -6,10 +6,13 @@
 #include "JSRuntime.hpp"
 #include "JSScope.hpp"
 #include "JSStackFrame.hpp"
+#include "JSString.hpp"
 #include "script/engine/JSCallable.hpp"
 #include "script/engine/JSExceptionType.hpp"
 #include "script/engine/JSValue.hpp"
 #include "script/util/BigInt.hpp"
+#include <istream>
+#include <memory>
 #include <string>
 
 class JSContext {
@@ -22,7 +25,7 @@ private:
 
   std::wstring _currentPath;
 
-  std::vector<JSStackFrame> _callstacks;
+  std::vector<JSCallFrame> _callstacks;
 
   JSValue *_Object{};
 
@@ -52,12 +55,36 @@ private:
 
   JSValue *_Promise{};
 
+  JSValue *_ObjectPrototype{};
+
+  JSValue *_FunctionPrototype{};
+
+  JSValue *_SymbolPrototype{};
+
+  JSValue *_ArrayPrototype{};
+
+  JSValue *_StringPrototype{};
+
+  JSValue *_NumberPrototype{};
+
+  JSValue *_BooleanPrototype{};
+
+  JSValue *_BigIntPrototype{};
+
+  JSValue *_GeneratorFunctionPrototype{};
+
+  JSValue *_GeneratorPrototype{};
+
 private:
   JSValue *_global{};
 
   JSAtom *_classContext{};
 
+  friend class JSPreparedCall;
+
 public:
+  static constexpr size_t STREAM_CHUNK_SIZE = 64 * 1024;
+
   JSContext(JSRuntime *runtime);
 
   ~JSContext();
@@ -66,17 +93,17 @@ public:
 
   JSValue *initializeGlobal();
 
-  void pushCallStack(const std::wstring &filename, const std::wstring &funcname,
-                     size_t column, size_t line);
+  void pushCallStack(const JSCallable *callee, const JSProgram *program,
+                     size_t pc);
 
   void popCallStack();
 
   std::vector<JSStackFrame> trace(const std::wstring &filename, size_t column,
                                   size_t line);
 
-  inline const std::vector<JSStackFrame> &getCallStack() { return _callstacks; }
+  inline const std::vector<JSCallFrame> &getCallStack() { return _callstacks; }
 
-  inline void setCallStack(const std::vector<JSStackFrame> &stacks) {
+  inline void setCallStack(const std::vector<JSCallFrame> &stacks) {
     _callstacks = stacks;
   }
 
@@ -89,6 +116,13 @@ public:
   JSValue *eval(const std::wstring &filename, const std::wstring &source,
                 const JS_EVAL_TYPE &type = JS_EVAL_TYPE::PROGRAM);
 
+  // reads the source in chunks of whole lines and runs each chunk's
+  // complete top-level statements before reading on, so only the
+  // statements in flight are ever parsed at once. Declarations hoist only
+  // within their chunk.
+  JSValue *evalStream(const std::wstring &filename, std::wistream &input,
+                      const JS_EVAL_TYPE &type = JS_EVAL_TYPE::PROGRAM);
+
   void pushScope();
 
   void popScope();
@@ -135,8 +169,12 @@ public:
 
   JSValue *createNumber(double value);
 
+  JSValue *createInteger(int32_t value);
+
   JSValue *createString(const std::wstring &value);
 
+  JSValue *createString(const std::shared_ptr<JSString::Rope> &rope);
+
   JSValue *createBoolean(bool value);
 
   JSValue *createObject(JSValue *prototype = nullptr);
@@ -170,8 +208,14 @@ public:
 
   JSValue *assigmentValue(JSValue *variable, JSValue *value);
 
+  JSValue *call(JSValue *func, JSValue *self, JSValue *const *argv,
+                size_t argc);
+
   JSValue *call(JSValue *func, JSValue *self,
-                const std::vector<JSValue *> args);
+                const std::vector<JSValue *> &args = {});
+
+  JSValue *construct(JSValue *constructor, JSValue *const *argv,
+                     size_t argc);
 
   JSValue *construct(JSValue *constructor,
                      const std::vector<JSValue *> &args = {});
@@ -186,6 +230,8 @@ public:
 
   JSValue *getField(JSValue *obj, JSValue *name);
 
+  JSValue *getPrimitivePrototype(JSValue *value);
+
   JSValue *setField(JSValue *obj, JSValue *name, JSValue *value);
 
   JSValue *defineProperty(JSValue *obj, JSValue *name, JSValue *value,
@@ -229,6 +275,8 @@ public:
 
   JSValue *add(JSValue *left, JSValue *right);
 
+  JSValue *concat(const std::vector<JSValue *> &values);
+
   JSValue *sub(JSValue *value, JSValue *another);
 
   JSValue *mul(JSValue *value, JSValue *another);
@@ -301,6 +349,28 @@ public:
 
   JSValue *getPromiseConstructor() { return _Promise; };
 
+  JSValue *getObjectPrototype() { return _ObjectPrototype; };
+
+  JSValue *getFunctionPrototype() { return _FunctionPrototype; };
+
+  JSValue *getSymbolPrototype() { return _SymbolPrototype; };
+
+  JSValue *getArrayPrototype() { return _ArrayPrototype; };
+
+  JSValue *getStringPrototype() { return _StringPrototype; };
+
+  JSValue *getNumberPrototype() { return _NumberPrototype; };
+
+  JSValue *getBooleanPrototype() { return _BooleanPrototype; };
+
+  JSValue *getBigIntPrototype() { return _BigIntPrototype; };
+
+  JSValue *getGeneratorFunctionPrototype() {
+    return _GeneratorFunctionPrototype;
+  };
+
+  JSValue *getGeneratorPrototype() { return _GeneratorPrototype; };
+
   JSValue *getCurrentClass() {
     return _classContext ? createValue(_classContext) : nullptr;
   }
@@ -327,4 +397,4 @@ public:
   }
 
 #define JS_CFUNCTION(name)                                                     \
-  JSValue *name(JSContext *ctx, JSValue *self, std::vector<JSValue *> args)
+  JSValue *name(JSContext *ctx, JSValue *self, JSArguments args)
@@ -6,6 +6,8 @@
 #include <vector>
 class JSException : public JSBase {
 public:
+  static constexpr uint32_t MASK = JSBase::MASK | (1u << 17);
+
   enum class TYPE { ERROR, INTERNAL, REFERENCE, SYNTAX, TYPE, RANGE };
 
 private:
@@ -2,6 +2,8 @@
 #include "JSType.hpp"
 class JSExceptionType : public JSType {
 public:
+  static constexpr uint32_t MASK = JSType::MASK | (1u << 16);
+
   JSExceptionType(JSAllocator *allocator);
 
 public:
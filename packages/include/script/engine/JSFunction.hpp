@@ -3,6 +3,9 @@
 #include "script/engine/JSType.hpp"
 #include <string>
 class JSFunction : public JSCallable {
+public:
+  static constexpr uint32_t MASK = JSCallable::MASK | (1u << 2);
+
 private:
   std::wstring _path;
 
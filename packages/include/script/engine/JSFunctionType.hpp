@@ -4,9 +4,11 @@
 #include "script/engine/JSValue.hpp"
 class JSFunctionType : public JSCallableType {
 public:
+  static constexpr uint32_t MASK = JSCallableType::MASK | (1u << 2);
+
   JSFunctionType(JSAllocator *allocator);
 
 public:
   JSValue *call(JSContext *ctx, JSValue *func, JSValue *self,
-                std::vector<JSValue *> args) const override;
+                JSArguments args) const override;
 };
\ No newline at end of file
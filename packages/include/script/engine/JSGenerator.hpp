@@ -5,6 +5,9 @@
 #include "script/util/JSAllocator.hpp"
 #include <vector>
 class JSGenerator : public JSObject {
+public:
+  static constexpr uint32_t MASK = JSObject::MASK | (1u << 6);
+
 private:
   JSAtom *_function{};
 
@@ -17,7 +20,9 @@ private:
   JSScope *_scope{};
 
 public:
-  JSGenerator(JSAllocator *allocator) : JSObject(allocator){};
+  JSGenerator(JSAllocator *allocator) : JSObject(allocator) {
+    _mask = MASK;
+  };
 
   void setFunctionCall(JSAtom *function, JSAtom *self,
                        const std::vector<JSAtom *> &args) {
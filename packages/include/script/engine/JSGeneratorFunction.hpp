@@ -2,6 +2,8 @@
 #include "script/engine/JSFunction.hpp"
 class JSGeneratorFunction : public JSFunction {
 public:
+  static constexpr uint32_t MASK = JSFunction::MASK | (1u << 3);
+
   JSGeneratorFunction(
       JSAllocator *allocator, const std::wstring &name = L"",
       const std::wstring &path = L"", size_t address = 0,
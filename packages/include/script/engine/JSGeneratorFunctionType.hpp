@@ -2,7 +2,9 @@
 #include "script/engine/JSFunctionType.hpp"
 class JSGeneratorFunctionType : public JSFunctionType {
 public:
+  static constexpr uint32_t MASK = JSFunctionType::MASK | (1u << 3);
+
   JSGeneratorFunctionType(JSAllocator *allocator);
   JSValue *call(JSContext *ctx, JSValue *func, JSValue *self,
-                std::vector<JSValue *> args) const override;
+                JSArguments args) const override;
 };
\ No newline at end of file
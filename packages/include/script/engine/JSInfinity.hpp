@@ -1,6 +1,9 @@
 #pragma once
 #include "script/engine/JSBase.hpp"
 class JSInfinity : public JSBase {
+public:
+  static constexpr uint32_t MASK = JSBase::MASK | (1u << 9);
+
 private:
   bool _negative;
 
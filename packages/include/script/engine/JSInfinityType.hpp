@@ -2,6 +2,8 @@
 #include "script/engine/JSNumberType.hpp"
 class JSInfinityType : public JSNumberType {
 public:
+  static constexpr uint32_t MASK = JSNumberType::MASK | (1u << 8);
+
   JSInfinityType(JSAllocator *allocator);
 
   JSValue *toNumber(JSContext *ctx, JSValue *value) const override;
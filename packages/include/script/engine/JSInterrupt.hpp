@@ -6,6 +6,9 @@
 #include "script/util/JSAllocator.hpp"
 #include "script/util/JSSingleton.hpp"
 class JSInterrupt : public JSBase {
+public:
+  static constexpr uint32_t MASK = JSBase::MASK | (1u << 18);
+
 private:
   JSEvalContext _ectx;
   JSScope *_scope;
@@ -15,7 +18,9 @@ public:
   JSInterrupt(JSAllocator *allocator, const JSEvalContext &ectx, JSScope *scope,
               JSAtom *value)
       : JSBase(allocator, JSSingleton::instance<JSInterruptType>(allocator)),
-        _ectx(ectx), _scope(scope), _value(value) {}
+        _ectx(ectx), _scope(scope), _value(value) {
+    _mask = MASK;
+  }
 
   inline JSEvalContext &getEvalContext() { return _ectx; }
 
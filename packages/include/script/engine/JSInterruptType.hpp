@@ -5,7 +5,11 @@
 
 class JSInterruptType : public JSType {
 public:
-  JSInterruptType(JSAllocator *allocator) : JSType(allocator) {}
+  static constexpr uint32_t MASK = JSType::MASK | (1u << 17);
+
+  JSInterruptType(JSAllocator *allocator) : JSType(allocator) {
+    _mask = MASK;
+  }
   
   JSValue *toString(JSContext *ctx, JSValue *value) const override {
     return ctx->createString(L"interrupt");
@@ -3,5 +3,7 @@
 #include "script/util/JSAllocator.hpp"
 class JSNaN : public JSBase {
 public:
+  static constexpr uint32_t MASK = JSBase::MASK | (1u << 8);
+
   JSNaN(JSAllocator *allocator);
 };
\ No newline at end of file
@@ -3,6 +3,8 @@
 #include "script/util/JSAllocator.hpp"
 class JSNaNType : public JSNumberType {
 public:
+  static constexpr uint32_t MASK = JSNumberType::MASK | (1u << 7);
+
   JSNaNType(JSAllocator *allocator);
 
   JSValue *toNumber(JSContext *ctx, JSValue *value) const override;
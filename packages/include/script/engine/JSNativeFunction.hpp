@@ -2,9 +2,14 @@
 
 #include "JSCallable.hpp"
 class JSNativeFunction : public JSCallable {
+public:
+  static constexpr uint32_t MASK = JSCallable::MASK | (1u << 4);
+
 private:
   JS_NATIVE _native;
 
+  JS_NATIVE_ENTRY _entry;
+
 public:
   JSNativeFunction(
       JSAllocator *allocator, const std::wstring &name, const JS_NATIVE &native,
@@ -13,4 +18,8 @@ public:
   inline const JS_NATIVE &getNative() const { return _native; }
 
   inline JS_NATIVE &getNative() { return _native; }
+
+  // set when the native is a plain function pointer, so calls can skip the
+  // std::function dispatch
+  inline JS_NATIVE_ENTRY getEntry() const { return _entry; }
 };
@@ -2,9 +2,11 @@
 #include "JSCallableType.hpp"
 class JSNativeFunctionType : public JSCallableType {
 public:
+  static constexpr uint32_t MASK = JSCallableType::MASK | (1u << 4);
+
   JSNativeFunctionType(JSAllocator *allocator);
 
 public:
   JSValue *call(JSContext *ctx, JSValue *func, JSValue *self,
-                std::vector<JSValue *> args) const override;
+                JSArguments args) const override;
 };
\ No newline at end of file
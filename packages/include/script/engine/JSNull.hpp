@@ -2,5 +2,7 @@
 #include "JSBase.hpp"
 class JSNull : public JSBase {
 public:
+  static constexpr uint32_t MASK = JSBase::MASK | (1u << 14);
+
   JSNull(JSAllocator *allocator);
 };
@@ -2,6 +2,8 @@
 #include "JSType.hpp"
 class JSNullType : public JSType {
 public:
+  static constexpr uint32_t MASK = JSType::MASK | (1u << 13);
+
   JSNullType(JSAllocator *allocator);
 
 public:
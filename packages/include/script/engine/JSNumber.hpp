@@ -1,11 +1,27 @@
 #pragma once
 #include "JSBase.hpp"
+#include <cstdint>
 class JSNumber : public JSBase {
+public:
+  static constexpr uint32_t MASK = JSBase::MASK | (1u << 7);
+
 private:
   double _value;
 
+  int32_t _integer;
+
+  bool _isInteger;
+
 public:
   JSNumber(JSAllocator *allocator, double value);
+  JSNumber(JSAllocator *allocator, int32_t value);
   inline double getValue() const { return _value; }
-  inline void setValue(double value) { _value = value; }
+  inline bool isInteger() const { return _isInteger; }
+  inline int32_t getInteger() const { return _integer; }
+  void setValue(double value);
+  inline void setInteger(int32_t value) {
+    _value = value;
+    _integer = value;
+    _isInteger = true;
+  }
 };
\ No newline at end of file
@@ -1,9 +1,24 @@
 #pragma once
+#include "JSString.hpp"
 #include "JSType.hpp"
+#include <array>
+#include <memory>
+#include <string>
 class JSNumberType : public JSType {
+public:
+  static constexpr uint32_t MASK = JSType::MASK | (1u << 6);
+
+  static constexpr int32_t SMALL_INTEGER_CACHE_SIZE = 256;
+
+private:
+  mutable std::array<std::shared_ptr<JSString::Rope>, SMALL_INTEGER_CACHE_SIZE>
+      _smallIntegers;
+
 public:
   JSNumberType(JSAllocator *allocator);
 
+  static std::wstring format(double value);
+
 public:
   const wchar_t *getTypeName() const override;
 
@@ -20,6 +35,8 @@ public:
   JSValue *equal(JSContext *ctx, JSValue *value,
                  JSValue *another) const override;
 
+  int32_t toInt32(JSValue *value) const;
+
 public:
   virtual JSValue *add(JSContext *ctx, JSValue *value, JSValue *another) const;
 
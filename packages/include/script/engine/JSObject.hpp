@@ -3,6 +3,7 @@
 #include "JSAtom.hpp"
 #include "JSType.hpp"
 #include <map>
+#include <memory>
 #include <string>
 #include <unordered_map>
 class JSContext;
@@ -18,6 +19,9 @@ struct JSField {
 };
 
 class JSObject : public JSBase {
+public:
+  static constexpr uint32_t MASK = JSBase::MASK | (1u << 0);
+
 private:
   std::map<JSAtom *, JSField> _fields;
   std::unordered_map<std::wstring, JSField> _privateFields;
@@ -26,6 +30,8 @@ private:
   bool _extensible;
   JSAtom *_prototype;
   JSAtom *_constructor;
+  const void *_opaqueTag;
+  std::shared_ptr<void> _opaque;
 
 public:
   JSObject(JSAllocator *allocator, JSType *type = nullptr);
@@ -70,4 +76,13 @@ public:
   inline void setFrozen(bool value) { _frozen = value; }
 
   inline void setExtensible(bool value) { _extensible = value; }
+
+  inline void *getOpaque(const void *tag) const {
+    return _opaqueTag == tag ? _opaque.get() : nullptr;
+  }
+
+  inline void setOpaque(const void *tag, const std::shared_ptr<void> &opaque) {
+    _opaqueTag = tag;
+    _opaque = opaque;
+  }
 };
\ No newline at end of file
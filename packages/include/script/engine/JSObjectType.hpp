@@ -6,6 +6,8 @@
 #include <string>
 class JSObjectType : public JSType {
 public:
+  static constexpr uint32_t MASK = JSType::MASK | (1u << 0);
+
   JSObjectType(JSAllocator *allocator);
 
 public:
@@ -42,6 +44,8 @@ public:
   JSValue *getConstructorOf(JSContext *ctx, JSValue *value) const;
 
 public:
+  virtual JSValue *materialize(JSContext *ctx, JSAtom *atom) const;
+
   virtual JSValue *getKeys(JSContext *ctx, JSValue *value) const;
 
   virtual JSValue *unpack(JSContext *ctx, JSValue *value) const;
@@ -49,8 +53,8 @@ public:
   virtual JSValue *setField(JSContext *ctx, JSValue *object, JSValue *name,
                             JSValue *value) const;
 
-  virtual JSValue *getField(JSContext *ctx, JSValue *object,
-                            JSValue *name) const;
+  virtual JSValue *getField(JSContext *ctx, JSValue *object, JSValue *name,
+                            JSValue *self = nullptr) const;
 
   JSValue *setPrivateField(JSContext *ctx, JSValue *object,
                            const std::wstring &name, JSValue *value) const;
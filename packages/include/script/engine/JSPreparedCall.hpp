@@ -0,0 +1,52 @@
+#pragma once
+#include "JSCallableType.hpp"
+#include "JSContext.hpp"
+#include "JSNumber.hpp"
+#include "JSScope.hpp"
+#include "JSValue.hpp"
+#include <vector>
+
+// Resolves a callee once so the host can invoke it repeatedly: the function,
+// receiver and closure bindings live in a scope owned by the prepared call,
+// and arguments are written into reserved slots instead of fresh vectors.
+// Number slots are reused between invocations; the callee binds parameters
+// by value, so only rest parameters observe the reuse. NaN and infinities
+// are not numbers in this engine and get shared values of their own.
+class JSPreparedCall {
+private:
+  JSContext *_ctx;
+  JSScope *_scope;
+  JSValue *_func;
+  JSValue *_self;
+  const JSCallableType *_type;
+  JSAtom *_clazz;
+  std::vector<JSValue *> _arguments;
+  std::vector<JSValue *> _numbers;
+  JSValue *_nan;
+  JSValue *_infinities[2];
+
+  JSValue *run();
+
+  JSValue *getNonFinite(double value);
+
+public:
+  JSPreparedCall(JSContext *ctx, JSValue *func, JSValue *self = nullptr,
+                 size_t argc = 0);
+
+  ~JSPreparedCall();
+
+  inline size_t getArgumentCount() const { return _arguments.size(); }
+
+  // the value must stay alive until the next invocation
+  inline void setArgument(size_t index, JSValue *value) {
+    _arguments[index] = value;
+  }
+
+  void setArgument(size_t index, double value);
+
+  JSValue *invoke();
+
+  // reads a number result without creating a value in the caller's scope,
+  // returns the exception on failure and nullptr otherwise
+  JSValue *invoke(double &result);
+};
@@ -1,8 +1,21 @@
 #pragma once
 #include "../compiler/JSCodeGenerator.hpp"
 #include "../compiler/JSParser.hpp"
+#include "../util/JSArenaAllocator.hpp"
 #include "../util/JSLogger.hpp"
 class JSVirtualMachine;
+
+// what compileChunk keeps between the chunks of one program: buffer holds
+// the source read but not compiled yet, which starts on line, and declared
+// the top-level names of the chunks compiled so far
+struct JSStreamState {
+  std::wstring buffer;
+  size_t line{1};
+  std::set<std::wstring> declared;
+  JS_EVAL_TYPE type{JS_EVAL_TYPE::PROGRAM};
+  bool started{};
+};
+
 class JSRuntime {
 private:
   JSParser *_parser{};
@@ -15,10 +28,21 @@ private:
 
   JSAllocator *_allocator{};
 
+  JSArenaAllocator *_arena{};
+
   std::unordered_map<std::wstring, JSProgram> _programs;
 
   std::vector<std::wstring> _args;
 
+  bool _lazy{true};
+
+private:
+  JSNode *createBytecodeError();
+
+  void compileProgram(JSParser *parser, JSCodeGenerator *generator,
+                      JSArenaAllocator *arena, JSProgram &program,
+                      const std::wstring &source, const JS_EVAL_TYPE &type);
+
 public:
   JSRuntime(int argc, char **argv);
 
@@ -60,4 +84,28 @@ public:
 
   JSProgram &compile(const std::wstring &path, const std::wstring &source,
                      const JS_EVAL_TYPE &type = JS_EVAL_TYPE::PROGRAM);
+
+  // compiles (path, source) pairs on up to threads workers, each with its
+  // own parser, generator and arena; 0 means one per core. Paths must be
+  // distinct, and the runtime allocator must be safe to share between
+  // threads, as the default one is.
+  void compileAll(
+      const std::vector<std::pair<std::wstring, std::wstring>> &sources,
+      const JS_EVAL_TYPE &type = JS_EVAL_TYPE::PROGRAM, size_t threads = 0);
+
+  // generates the body of the LAZY stub at pc and turns the stub into a
+  // jump to it; returns the syntax error, if any, owned by the caller
+  JSNode *compileFunction(const std::wstring &path, size_t pc);
+
+  // appends the complete top-level statements at the head of the stream
+  // to the program at path and drops them from the buffer. Unless final
+  // is set the last statement stays behind, since more input may extend
+  // it, and a syntax error only means the buffer needs more input. Returns
+  // the error, if any, owned by the caller.
+  JSNode *compileChunk(const std::wstring &path, JSStreamState &stream,
+                       bool final);
+
+  void setLazy(bool lazy) { _lazy = lazy; }
+
+  bool isLazy() const { return _lazy; }
 };
\ No newline at end of file
@@ -3,4 +3,15 @@
 struct JSStackFrame {
   JSPosition position;
   std::wstring filename;
+};
+
+struct JSProgram;
+class JSCallable;
+
+// call-stack entry kept while running; names and source positions are only
+// resolved into JSStackFrame when a trace is requested
+struct JSCallFrame {
+  const JSCallable *callee{};
+  const JSProgram *program{};
+  size_t pc{};
 };
\ No newline at end of file
@@ -1,13 +1,41 @@
 #pragma once
 
 #include "JSBase.hpp"
+#include <memory>
 #include <string>
 class JSString : public JSBase {
+public:
+  static constexpr uint32_t MASK = JSBase::MASK | (1u << 10);
+
+  struct Rope {
+    std::shared_ptr<Rope> left;
+    std::shared_ptr<Rope> right;
+    std::wstring value;
+    size_t length;
+
+    Rope(std::wstring value)
+        : value(std::move(value)), length(this->value.length()) {}
+
+    Rope(const std::shared_ptr<Rope> &left, const std::shared_ptr<Rope> &right)
+        : left(left), right(right), length(left->length + right->length) {}
+
+    ~Rope();
+
+    bool isFlat() const { return left == nullptr; }
+
+    const std::wstring &flatten();
+  };
+
 private:
-  std::wstring _value;
+  std::shared_ptr<Rope> _rope;
 
 public:
   JSString(JSAllocator *allocator, const std::wstring &value);
-  const std::wstring &getValue() const { return _value; }
-  void setValue(const std::wstring &value) { _value = value; }
+  JSString(JSAllocator *allocator, const std::shared_ptr<Rope> &rope);
+  const std::wstring &getValue() const { return _rope->flatten(); }
+  void setValue(const std::wstring &value) {
+    _rope = std::make_shared<Rope>(value);
+  }
+  inline size_t getLength() const { return _rope->length; }
+  inline const std::shared_ptr<Rope> &getRope() const { return _rope; }
 };
@@ -1,9 +1,21 @@
 #pragma once
 #include "JSType.hpp"
+#include <string>
+#include <vector>
 class JSStringType : public JSType {
+public:
+  static constexpr uint32_t MASK = JSType::MASK | (1u << 9);
+
+  static constexpr size_t MIN_ROPE_LENGTH = 64;
+
+private:
+  static bool isWhiteSpace(wchar_t chr);
+
 public:
   JSStringType(JSAllocator *allocator);
 
+  static double parseNumber(const std::wstring &source);
+
 public:
   const wchar_t *getTypeName() const override;
 
@@ -19,6 +31,11 @@ public:
 
   JSValue *equal(JSContext *ctx, JSValue *value,
                  JSValue *another) const override;
-                 
+
+  JSValue *getOwnField(JSContext *ctx, JSValue *value, JSValue *name) const;
+
   virtual JSValue *add(JSContext *ctx, JSValue *value, JSValue *another) const;
+
+  virtual JSValue *concat(JSContext *ctx,
+                          const std::vector<JSValue *> &values) const;
 };
\ No newline at end of file
@@ -2,6 +2,9 @@
 #include "JSBase.hpp"
 #include <string>
 class JSSymbol : public JSBase {
+public:
+  static constexpr uint32_t MASK = JSBase::MASK | (1u << 13);
+
 private:
   std::wstring _description;
 
@@ -2,6 +2,8 @@
 #include "JSType.hpp"
 class JSSymbolType : public JSType {
 public:
+  static constexpr uint32_t MASK = JSType::MASK | (1u << 12);
+
   JSSymbolType(JSAllocator *allocator);
 
 public:
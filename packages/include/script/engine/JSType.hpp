@@ -1,13 +1,21 @@
 #pragma once
 #include "script/util/JSAllocator.hpp"
 #include "script/util/JSRef.hpp"
+#include <cstdint>
 class JSContext;
 class JSValue;
 class JSType : public JSRef {
-private:
+protected:
+  uint32_t _mask{};
+
+public:
+  static constexpr uint32_t MASK = 0;
+
 public:
   JSType(JSAllocator *allocator) : JSRef(allocator) {}
 
+  inline uint32_t getMask() const { return _mask; }
+
   virtual ~JSType() = default;
 
   virtual const wchar_t *getTypeName() const { return L"internal"; };
@@ -27,8 +35,16 @@ public:
 
 public:
   template <class T> const T *cast() const {
-    return dynamic_cast<const T *>(this);
+    if ((_mask & T::MASK) != T::MASK) {
+      return nullptr;
+    }
+    return static_cast<const T *>(this);
   }
 
-  template <class T> T *cast() { return dynamic_cast<T *>(this); }
+  template <class T> T *cast() {
+    if ((_mask & T::MASK) != T::MASK) {
+      return nullptr;
+    }
+    return static_cast<T *>(this);
+  }
 };
\ No newline at end of file
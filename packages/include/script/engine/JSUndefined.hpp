@@ -3,5 +3,7 @@
 #include "JSBase.hpp"
 class JSUndefined : public JSBase {
 public:
+  static constexpr uint32_t MASK = JSBase::MASK | (1u << 15);
+
   JSUndefined(JSAllocator *allocator);
 };
\ No newline at end of file
@@ -2,6 +2,8 @@
 #include "JSType.hpp"
 class JSUndefinedType : public JSType {
 public:
+  static constexpr uint32_t MASK = JSType::MASK | (1u << 14);
+
   JSUndefinedType(JSAllocator *allocator);
 
 public:
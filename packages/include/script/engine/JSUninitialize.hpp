@@ -2,5 +2,7 @@
 #include "JSBase.hpp"
 class JSUninitialize : public JSBase {
 public:
+  static constexpr uint32_t MASK = JSBase::MASK | (1u << 16);
+
   JSUninitialize(JSAllocator *allocator);
 };
@@ -2,6 +2,8 @@
 #include "JSType.hpp"
 class JSUninitializeType : public JSType {
 public:
+  static constexpr uint32_t MASK = JSType::MASK | (1u << 15);
+
   JSUninitializeType(JSAllocator *allocator);
 
 public:
@@ -1,4 +1,5 @@
 #pragma once
+#include "../compiler/JSBytecode.hpp"
 #include "../compiler/JSProgram.hpp"
 #include "../util/JSAllocator.hpp"
 #include "JSContext.hpp"
@@ -30,23 +31,18 @@ private:
 
 private:
   uint32_t getUint32(const JSProgram &program, size_t &address) {
-    auto val = *(uint32_t *)(program.codes.data() + address);
-    address += 2;
-    return val;
+    return JSBytecode::readVarint(program.codes.data(), address);
   }
   size_t getAddress(const JSProgram &program, size_t &address) {
-    auto val = *(size_t *)(program.codes.data() + address);
-    address += 4;
-    return val;
+    return JSBytecode::readAddress(program.codes.data(), address);
   }
   double getNumber(const JSProgram &program, size_t &address) {
-    auto val = *(double *)(program.codes.data() + address);
-    address += 4;
-    return val;
+    return JSBytecode::readNumber(program.codes.data(), address);
   }
-  const std::wstring &getString(const JSProgram &program, size_t &address) {
+  const std::wstring &getIdentifier(const JSProgram &program,
+                                    size_t &address) {
     auto idx = getUint32(program, address);
-    return program.constants[idx];
+    return program.identifiers[idx];
   }
 
   bool checkException(JSContext *ctx, JSValue *value, JSEvalContext &ectx,
@@ -61,27 +57,23 @@ private:
 
 private:
   JSValue *call(JSContext *ctx, JSValue *func, JSValue *self,
-                std::vector<JSValue *> args = {},
-                const JSStackFrame &frame = {}) {
+                JSArguments args = {}, const JSProgram *program = nullptr,
+                size_t pc = 0) {
     auto fn = func->getData()->cast<JSCallable>();
     if (!fn) {
       return ctx->createException(JSException::TYPE::TYPE,
                                   L"variable is not a function");
     }
-    ctx->pushCallStack(frame.filename,
-                       frame.position.funcname.empty()
-                           ? fn->getName()
-                           : frame.position.funcname,
-                       frame.position.column, frame.position.line);
-    auto res = ctx->call(func, self, args);
+    ctx->pushCallStack(fn, program, pc);
+    auto res = ctx->call(func, self, args.data(), args.size());
     ctx->popCallStack();
     return res;
   }
-  JSValue *construct(JSContext *ctx, JSValue *constructor,
-                     std::vector<JSValue *> args, const JSStackFrame &frame) {
-    ctx->pushCallStack(frame.filename, frame.position.funcname,
-                       frame.position.column, frame.position.line);
-    auto res = ctx->construct(constructor, args);
+  JSValue *construct(JSContext *ctx, JSValue *constructor, JSArguments args,
+                     const JSProgram &program, size_t pc) {
+    ctx->pushCallStack(constructor->getData()->cast<JSCallable>(), &program,
+                       pc);
+    auto res = ctx->construct(constructor, args.data(), args.size());
     ctx->popCallStack();
     return res;
   }
@@ -128,21 +120,15 @@ private:
   }
   void runRegex(JSContext *ctx, const JSProgram &program, JSEvalContext &ectx) {
     // not implement
+    getUint32(program, ectx.pc);
   }
   void runBigint(JSContext *ctx, const JSProgram &program,
                  JSEvalContext &ectx) {
-    auto init = getString(program, ectx.pc);
-    ectx.stack.push_back(ctx->createBigInt(init));
+    auto idx = getUint32(program, ectx.pc);
+    ectx.stack.push_back(ctx->createBigInt(program.bigints.at(idx)));
   }
   void runLoad(JSContext *ctx, const JSProgram &program, JSEvalContext &ectx) {
-    auto name = getString(program, ectx.pc);
-    if (name == L"NaN") {
-      ectx.stack.push_back(ctx->createNaN());
-      return;
-    } else if (name == L"Infinity") {
-      ectx.stack.push_back(ctx->createInfinity());
-      return;
-    }
+    auto name = getIdentifier(program, ectx.pc);
     auto val = ctx->queryValue(name);
     if (checkException(ctx, val, ectx, program)) {
       return;
@@ -150,7 +136,7 @@ private:
     ectx.stack.push_back(val);
   }
   void runStore(JSContext *ctx, const JSProgram &program, JSEvalContext &ectx) {
-    auto name = getString(program, ectx.pc);
+    auto name = getIdentifier(program, ectx.pc);
     auto value = *ectx.stack.rbegin();
     ectx.stack.pop_back();
     auto variable = ctx->queryValue(name);
@@ -164,9 +150,9 @@ private:
     ectx.stack.push_back(res);
   }
   void runRef(JSContext *ctx, const JSProgram &program, JSEvalContext &ectx) {
-    auto identifier = getString(program, ectx.pc);
+    auto identifier = getIdentifier(program, ectx.pc);
     auto func = *ectx.stack.rbegin();
-    auto callable = dynamic_cast<JSCallable *>(func->getData());
+    auto callable = func->getData()->cast<JSCallable>();
     auto val = ctx->queryValue(identifier);
     if (checkException(ctx, val, ectx, program)) {
       return;
@@ -179,22 +165,30 @@ private:
     func->getAtom()->addChild(val->getAtom());
   }
   void runStr(JSContext *ctx, const JSProgram &program, JSEvalContext &ectx) {
-    auto str = getString(program, ectx.pc);
-    ectx.stack.push_back(ctx->createString(str));
+    auto idx = getUint32(program, ectx.pc);
+    ectx.stack.push_back(ctx->createString(program.stringValues[idx]));
+  }
+  void runLoadNaN(JSContext *ctx, const JSProgram &program,
+                  JSEvalContext &ectx) {
+    ectx.stack.push_back(ctx->createNaN());
+  }
+  void runLoadInfinity(JSContext *ctx, const JSProgram &program,
+                       JSEvalContext &ectx) {
+    ectx.stack.push_back(ctx->createInfinity());
   }
   void runVar(JSContext *ctx, const JSProgram &program, JSEvalContext &ectx) {
-    auto name = getString(program, ectx.pc);
+    auto name = getIdentifier(program, ectx.pc);
     auto val = ctx->createUndefined();
     ctx->getScope()->storeValue(name, val);
   }
   void runConst(JSContext *ctx, const JSProgram &program, JSEvalContext &ectx) {
-    auto name = getString(program, ectx.pc);
+    auto name = getIdentifier(program, ectx.pc);
     auto val = ctx->createUninitialized();
     val->setConst(true);
     ctx->getScope()->storeValue(name, val);
   }
   void runLet(JSContext *ctx, const JSProgram &program, JSEvalContext &ectx) {
-    auto name = getString(program, ectx.pc);
+    auto name = getIdentifier(program, ectx.pc);
     auto val = ctx->createUninitialized();
     ctx->getScope()->storeValue(name, val);
   }
@@ -241,16 +235,19 @@ private:
     ectx.pc = program.codes.size();
   }
   void runEnable(JSContext *ctx, const JSProgram &program,
-                 JSEvalContext &ectx) {}
+                 JSEvalContext &ectx) {
+    getIdentifier(program, ectx.pc);
+  }
   void runDisable(JSContext *ctx, const JSProgram &program,
-                  JSEvalContext &ectx) {}
+                  JSEvalContext &ectx) {
+    getIdentifier(program, ectx.pc);
+  }
   void runGetField(JSContext *ctx, const JSProgram &program,
                    JSEvalContext &ectx) {
     auto obj = *ectx.stack.rbegin();
     ectx.stack.pop_back();
     auto field = *ectx.stack.rbegin();
     ectx.stack.pop_back();
-    obj = ctx->pack(obj);
     auto result = ctx->getField(obj, field);
     if (result->getType() == JSSingleton::query<JSExceptionType>()) {
       ectx.stack.push_back(result);
@@ -304,6 +301,12 @@ private:
     auto getter = *ectx.stack.rbegin();
     ectx.stack.pop_back();
     obj = ctx->pack(obj);
+    auto err =
+        obj->getType()->cast<JSObjectType>()->materialize(ctx, obj->getAtom());
+    if (err) {
+      checkException(ctx, err, ectx, program);
+      return;
+    }
     auto object = obj->getData()->cast<JSObject>();
     auto &fields = object->getFields();
     JSField *field = nullptr;
@@ -350,6 +353,12 @@ private:
     auto setter = *ectx.stack.rbegin();
     ectx.stack.pop_back();
     obj = ctx->pack(obj);
+    auto err =
+        obj->getType()->cast<JSObjectType>()->materialize(ctx, obj->getAtom());
+    if (err) {
+      checkException(ctx, err, ectx, program);
+      return;
+    }
     auto object = obj->getData()->cast<JSObject>();
     auto &fields = object->getFields();
     JSField *field = nullptr;
@@ -408,19 +417,14 @@ private:
     ectx.pc = program.codes.size();
   }
   void runCall(JSContext *ctx, const JSProgram &program, JSEvalContext &ectx) {
-    auto frame = program.stacks.at(ectx.pc);
+    auto pc = ectx.pc;
     auto size = (uint32_t)ctx->checkedNumber(*ectx.stack.rbegin());
     ectx.stack.pop_back();
-    std::vector<JSValue *> arguments;
-    for (size_t index = 0; index < size; index++) {
-      auto val = *ectx.stack.rbegin();
-      ectx.stack.pop_back();
-      arguments.push_back(val);
-    }
-    auto func = *ectx.stack.rbegin();
-    ectx.stack.pop_back();
+    auto base = ectx.stack.size() - size;
+    auto func = ectx.stack[base - 1];
     auto result = call(ctx, func, ctx->createUndefined(),
-                       {arguments.rbegin(), arguments.rend()}, frame);
+                       {ectx.stack.data() + base, size}, &program, pc);
+    ectx.stack.resize(base - 1);
     if (checkException(ctx, result, ectx, program)) {
       return;
     }
@@ -428,25 +432,19 @@ private:
   }
   void runMemberCall(JSContext *ctx, const JSProgram &program,
                      JSEvalContext &ectx) {
-    auto frame = program.stacks.at(ectx.pc);
+    auto pc = ectx.pc;
     auto size = (uint32_t)ctx->checkedNumber(*ectx.stack.rbegin());
     ectx.stack.pop_back();
-    std::vector<JSValue *> arguments;
-    for (size_t index = 0; index < size; index++) {
-      auto val = *ectx.stack.rbegin();
-      ectx.stack.pop_back();
-      arguments.push_back(val);
-    }
-    auto field = *ectx.stack.rbegin();
-    ectx.stack.pop_back();
-    auto obj = *ectx.stack.rbegin();
-    ectx.stack.pop_back();
-    obj = ctx->pack(obj);
+    auto base = ectx.stack.size() - size;
+    auto field = ectx.stack[base - 1];
+    auto obj = ectx.stack[base - 2];
     auto func = ctx->getField(obj, field);
     if (checkException(ctx, func, ectx, program)) {
       return;
     }
-    auto result = call(ctx, func, obj, arguments, frame);
+    auto result =
+        call(ctx, func, obj, {ectx.stack.data() + base, size}, &program, pc);
+    ectx.stack.resize(base - 2);
     if (checkException(ctx, result, ectx, program)) {
       return;
     }
@@ -472,19 +470,13 @@ private:
   }
 
   void runNew(JSContext *ctx, const JSProgram &program, JSEvalContext &ectx) {
-    auto frame = program.stacks.at(ectx.pc);
+    auto pc = ectx.pc;
     auto size = getUint32(program, ectx.pc);
-    std::vector<JSValue *> arguments;
-    for (size_t index = 0; index < size; index++) {
-      auto val = *ectx.stack.rbegin();
-      ectx.stack.pop_back();
-      arguments.push_back(val);
-    }
-    auto constructor = *ectx.stack.rbegin();
-    ectx.stack.pop_back();
-    frame.position.funcname =
-        constructor->getData()->cast<JSCallable>()->getName();
-    auto result = construct(ctx, constructor, arguments, frame);
+    auto base = ectx.stack.size() - size;
+    auto constructor = ectx.stack[base - 1];
+    auto result = construct(ctx, constructor, {ectx.stack.data() + base, size},
+                            program, pc);
+    ectx.stack.resize(base - 1);
     if (checkException(ctx, result, ectx, program)) {
       return;
     }
@@ -556,6 +548,21 @@ private:
     auto address = getAddress(program, ectx.pc);
     ectx.pc = address;
   }
+  void runLazy(JSContext *ctx, const JSProgram &program, JSEvalContext &ectx) {
+    auto pc = ectx.pc - 1;
+    auto runtime = ctx->getRuntime();
+    auto err = runtime->compileFunction(program.filename, pc);
+    if (err) {
+      auto error = err->cast<JSErrorNode>();
+      auto exception = ctx->createException(
+          JSException::TYPE::SYNTAX, error->message, program.filename,
+          error->location.end.column, error->location.end.line);
+      runtime->getAllocator()->dispose(err);
+      checkException(ctx, exception, ectx, program);
+      return;
+    }
+    ectx.pc = pc;
+  }
   void runJtrue(JSContext *ctx, const JSProgram &program, JSEvalContext &ectx) {
     auto address = getAddress(program, ectx.pc);
     auto value = *ectx.stack.rbegin();
@@ -619,6 +626,17 @@ private:
     }
     ectx.stack.push_back(val);
   }
+  void runConcat(JSContext *ctx, const JSProgram &program,
+                 JSEvalContext &ectx) {
+    auto size = getUint32(program, ectx.pc);
+    std::vector<JSValue *> parts(ectx.stack.end() - size, ectx.stack.end());
+    ectx.stack.resize(ectx.stack.size() - size);
+    auto val = ctx->concat(parts);
+    if (checkException(ctx, val, ectx, program)) {
+      return;
+    }
+    ectx.stack.push_back(val);
+  }
   void runSub(JSContext *ctx, const JSProgram &program, JSEvalContext &ectx) {
 
     auto right = *ectx.stack.rbegin();
@@ -1357,14 +1375,14 @@ private:
   }
   void runSetFunctionName(JSContext *ctx, const JSProgram &program,
                           JSEvalContext &ectx) {
-    auto name = getString(program, ectx.pc);
+    auto name = getIdentifier(program, ectx.pc);
     auto func = *ectx.stack.rbegin();
-    dynamic_cast<JSCallable *>(func->getData())->setName(name);
+    func->getData()->cast<JSCallable>()->setName(name);
   }
 
   void runBreakLabelBegin(JSContext *ctx, const JSProgram &program,
                           JSEvalContext &ectx) {
-    auto label = getString(program, ectx.pc);
+    auto label = getIdentifier(program, ectx.pc);
     ectx.labels.push_back({
         .type = JSLabelFrame::TYPE::BREAK,
         .label = label,
@@ -1376,7 +1394,7 @@ private:
   }
   void runContinueLabelBegin(JSContext *ctx, const JSProgram &program,
                              JSEvalContext &ectx) {
-    auto label = getString(program, ectx.pc);
+    auto label = getIdentifier(program, ectx.pc);
     ectx.labels.push_back({
         .type = JSLabelFrame::TYPE::CONTINUE,
         .label = label,
@@ -1424,7 +1442,7 @@ private:
   }
 
   void runBreak(JSContext *ctx, const JSProgram &program, JSEvalContext &ectx) {
-    auto name = getString(program, ectx.pc);
+    auto name = getIdentifier(program, ectx.pc);
     for (auto label = ectx.labels.rbegin(); label != ectx.labels.rend();
          label++) {
       if (label->label == name && label->type == JSLabelFrame::TYPE::BREAK) {
@@ -1439,7 +1457,7 @@ private:
 
   void runContinue(JSContext *ctx, const JSProgram &program,
                    JSEvalContext &ectx) {
-    auto name = getString(program, ectx.pc);
+    auto name = getIdentifier(program, ectx.pc);
     for (auto label = ectx.labels.rbegin(); label != ectx.labels.rend();
          label++) {
       if (label->label == name && label->type == JSLabelFrame::TYPE::CONTINUE) {
@@ -1647,6 +1665,15 @@ private:
     case JS_OPERATOR::JMP:
       runJmp(ctx, program, ectx);
       break;
+    case JS_OPERATOR::LOAD_NAN:
+      runLoadNaN(ctx, program, ectx);
+      break;
+    case JS_OPERATOR::LOAD_INFINITY:
+      runLoadInfinity(ctx, program, ectx);
+      break;
+    case JS_OPERATOR::LAZY:
+      runLazy(ctx, program, ectx);
+      break;
     case JS_OPERATOR::JTRUE:
       runJtrue(ctx, program, ectx);
       break;
@@ -1668,6 +1695,9 @@ private:
     case JS_OPERATOR::ADD:
       runAdd(ctx, program, ectx);
       break;
+    case JS_OPERATOR::CONCAT:
+      runConcat(ctx, program, ectx);
+      break;
     case JS_OPERATOR::SUB:
       runSub(ctx, program, ectx);
       break;
@@ -1892,7 +1922,7 @@ private:
           } else {
             ectx.pc = frame.onfinish;
             ectx.tryFrames.pop_back();
-            ectx.defer.push_back(program.codes.size());
+            ectx.defer.push_back(SIZE_MAX);
             ectx.result = result;
           }
         } else {
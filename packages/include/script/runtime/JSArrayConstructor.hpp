@@ -9,11 +9,9 @@ private:
     static JS_CFUNCTION(iterator);
   };
 
-  static JSValue *constructor(JSContext *ctx, JSValue *self,
-                              std::vector<JSValue *> args);
+  static JSValue *constructor(JSContext *ctx, JSValue *self, JSArguments args);
 
-  static JSValue *toString(JSContext *ctx, JSValue *self,
-                           std::vector<JSValue *> args);
+  static JSValue *toString(JSContext *ctx, JSValue *self, JSArguments args);
 
   static JS_CFUNCTION(iterator);
 
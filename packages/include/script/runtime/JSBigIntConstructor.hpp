@@ -2,14 +2,11 @@
 #include "script/engine/JSContext.hpp"
 class JSBigIntConstructor {
 private:
-  static JSValue *constructor(JSContext *ctx, JSValue *self,
-                              std::vector<JSValue *> args);
+  static JSValue *constructor(JSContext *ctx, JSValue *self, JSArguments args);
 
-  static JSValue *toString(JSContext *ctx, JSValue *self,
-                           std::vector<JSValue *> args);
+  static JSValue *toString(JSContext *ctx, JSValue *self, JSArguments args);
 
-  static JSValue *valueOf(JSContext *ctx, JSValue *self,
-                          std::vector<JSValue *> args);
+  static JSValue *valueOf(JSContext *ctx, JSValue *self, JSArguments args);
 
 public:
   static JSValue *initialize(JSContext *ctx);
@@ -3,14 +3,11 @@
 class JSBooleanConstructor {
 public:
 private:
-  static JSValue *constructor(JSContext *ctx, JSValue *self,
-                              std::vector<JSValue *> args);
+  static JSValue *constructor(JSContext *ctx, JSValue *self, JSArguments args);
 
-  static JSValue *toString(JSContext *ctx, JSValue *self,
-                           std::vector<JSValue *> args);
+  static JSValue *toString(JSContext *ctx, JSValue *self, JSArguments args);
 
-  static JSValue *valueOf(JSContext *ctx, JSValue *self,
-                              std::vector<JSValue *> args);
+  static JSValue *valueOf(JSContext *ctx, JSValue *self, JSArguments args);
 
 public:
   static JSValue *initialize(JSContext *ctx);
@@ -4,11 +4,9 @@
 #include <vector>
 class JSFunctionConstructor {
 private:
-  static JSValue *constructor(JSContext *ctx, JSValue *self,
-                              std::vector<JSValue *> args);
+  static JSValue *constructor(JSContext *ctx, JSValue *self, JSArguments args);
 
-  static JSValue *toString(JSContext *ctx, JSValue *self,
-                           std::vector<JSValue *> args);
+  static JSValue *toString(JSContext *ctx, JSValue *self, JSArguments args);
 
 public:
   static JSValue *initialize(JSContext *ctx);
@@ -4,8 +4,7 @@
 #include <vector>
 class JSGeneratorConstructor {
 private:
-  static JSValue *constructor(JSContext *ctx, JSValue *self,
-                              std::vector<JSValue *> args);
+  static JSValue *constructor(JSContext *ctx, JSValue *self, JSArguments args);
 
   static JS_CFUNCTION(next);
 
@@ -2,8 +2,7 @@
 #include "script/engine/JSContext.hpp"
 class JSGeneratorFunctionConstructor {
 private:
-  static JSValue *constructor(JSContext *ctx, JSValue *self,
-                              std::vector<JSValue *> args);
+  static JSValue *constructor(JSContext *ctx, JSValue *self, JSArguments args);
 
 public:
   static JSValue *initialize(JSContext *ctx);
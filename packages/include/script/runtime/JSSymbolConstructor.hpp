@@ -4,20 +4,15 @@
 #include <vector>
 class JSSymbolConstructor {
 private:
-  static JSValue *toString(JSContext *ctx, JSValue *self,
-                           std::vector<JSValue *> args);
+  static JSValue *toString(JSContext *ctx, JSValue *self, JSArguments args);
 
-  static JSValue *constructor(JSContext *ctx, JSValue *self,
-                              std::vector<JSValue *> args);
+  static JSValue *constructor(JSContext *ctx, JSValue *self, JSArguments args);
 
-  static JSValue *toPrimitive(JSContext *ctx, JSValue *self,
-                              std::vector<JSValue *> args);
+  static JSValue *toPrimitive(JSContext *ctx, JSValue *self, JSArguments args);
 
-  static JSValue *for_(JSContext *ctx, JSValue *self,
-                       std::vector<JSValue *> args);
+  static JSValue *for_(JSContext *ctx, JSValue *self, JSArguments args);
 
-  static JSValue *keyFor(JSContext *ctx, JSValue *self,
-                         std::vector<JSValue *> args);
+  static JSValue *keyFor(JSContext *ctx, JSValue *self, JSArguments args);
 
 public:
   static JSValue *initialize(JSContext *ctx);
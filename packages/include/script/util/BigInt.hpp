@@ -1,169 +1,512 @@
 #pragma once
-#include <cmath>
+#include <algorithm>
+#include <bit>
 #include <cstdint>
 #include <optional>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <vector>
 
-template <class T = uint8_t> class BigInt {
-private:
-  std::vector<T> _data{};
-  bool _negative{};
+template <class T = uint64_t> class BigInt {
+  static_assert(std::is_same_v<T, uint64_t>, "BigInt uses 64-bit limbs");
 
 public:
-  BigInt() : _data({0}), _negative(false) {}
+  static constexpr size_t KARATSUBA_THRESHOLD = 32;
 
-  BigInt(const BigInt &another)
-      : _data(another._data), _negative(another._negative) {}
+  static constexpr size_t DECIMAL_THRESHOLD = 32;
 
-  BigInt(BigInt &&another)
-      : _data(another._data), _negative(another._negative) {}
+private:
+  static constexpr T DECIMAL_BASE = 10000000000000000000ull;
 
-  BigInt(int64_t number) : _negative(number < 0) {
-    static uint64_t max = (uint64_t)((T)-1) + 1;
-    if (number < 0) {
-      number = -number;
+  static constexpr size_t DECIMAL_DIGITS = 19;
+
+  using Limbs = std::vector<T>;
+  using Wide = unsigned __int128;
+
+  // magnitude in little-endian limbs without leading zero limbs,
+  // zero is an empty vector
+  Limbs _data{};
+  bool _negative{};
+
+private:
+  static void trim(Limbs &data) {
+    while (!data.empty() && data.back() == 0) {
+      data.pop_back();
     }
-    while (number > 0) {
-      _data.push_back((T)(number % max));
-      number >>= (sizeof(T) * 8);
+  }
+
+  static int compare(const Limbs &a, const Limbs &b) {
+    if (a.size() != b.size()) {
+      return a.size() > b.size() ? 1 : -1;
     }
-    if (_data.empty()) {
-      _data.push_back(0);
+    for (size_t index = a.size(); index > 0; index--) {
+      if (a[index - 1] != b[index - 1]) {
+        return a[index - 1] > b[index - 1] ? 1 : -1;
+      }
     }
+    return 0;
   }
 
-  BigInt(const std::wstring &source) : _data({0}), _negative(false) {
-    auto chr = source.c_str();
-    if (*chr == L'+') {
-      chr++;
-    } else if (*chr == L'-') {
-      _negative = true;
-      chr++;
+  static Limbs add(const Limbs &a, const Limbs &b) {
+    const Limbs &large = a.size() >= b.size() ? a : b;
+    const Limbs &small = a.size() >= b.size() ? b : a;
+    Limbs result(large.size() + 1);
+    T carry = 0;
+    for (size_t index = 0; index < large.size(); index++) {
+      Wide sum = (Wide)large[index] + carry;
+      if (index < small.size()) {
+        sum += small[index];
+      }
+      result[index] = (T)sum;
+      carry = (T)(sum >> 64);
     }
-    while (*chr) {
-      if (*chr < '0' || *chr > '9') {
-        throw std::runtime_error("Cannot convert to a BigInt");
+    result[large.size()] = carry;
+    trim(result);
+    return result;
+  }
+
+  // requires a >= b
+  static Limbs sub(const Limbs &a, const Limbs &b) {
+    Limbs result(a.size());
+    T borrow = 0;
+    for (size_t index = 0; index < a.size(); index++) {
+      Wide diff = (Wide)a[index] - borrow;
+      if (index < b.size()) {
+        diff -= b[index];
       }
-      *this *= 10;
-      *this += (uint64_t)(*chr - '0');
-      chr++;
+      result[index] = (T)diff;
+      borrow = (diff >> 64) ? 1 : 0;
+    }
+    trim(result);
+    return result;
+  }
+
+  static void addShifted(Limbs &result, const Limbs &value, size_t offset) {
+    T carry = 0;
+    size_t index = 0;
+    for (; index < value.size(); index++) {
+      Wide sum = (Wide)result[offset + index] + value[index] + carry;
+      result[offset + index] = (T)sum;
+      carry = (T)(sum >> 64);
     }
-    while (*_data.rbegin() == 0) {
-      _data.pop_back();
+    for (; carry != 0; index++) {
+      Wide sum = (Wide)result[offset + index] + carry;
+      result[offset + index] = (T)sum;
+      carry = (T)(sum >> 64);
     }
-    if (_data.empty()) {
-      _data.push_back(0);
+  }
+
+  static Limbs mulSchool(const Limbs &a, const Limbs &b) {
+    Limbs result(a.size() + b.size());
+    for (size_t i = 0; i < a.size(); i++) {
+      T carry = 0;
+      for (size_t j = 0; j < b.size(); j++) {
+        Wide cur = (Wide)a[i] * b[j] + result[i + j] + carry;
+        result[i + j] = (T)cur;
+        carry = (T)(cur >> 64);
+      }
+      result[i + b.size()] = carry;
     }
+    trim(result);
+    return result;
   }
 
-  std::wstring toString() const {
-    std::wstring result;
-    BigInt<> tmp = *this;
-    tmp._negative = 0;
-    if (tmp == 0) {
-      result += L"0";
-    } else {
-      while (tmp > 0) {
-        result += (tmp % 10)._data[0] + '0';
-        tmp /= 10;
+  static Limbs mul(const Limbs &a, const Limbs &b) {
+    if (a.empty() || b.empty()) {
+      return {};
+    }
+    if (a.size() < KARATSUBA_THRESHOLD || b.size() < KARATSUBA_THRESHOLD) {
+      return mulSchool(a, b);
+    }
+    size_t half = (std::max(a.size(), b.size()) + 1) / 2;
+    auto low = [=](const Limbs &value) {
+      Limbs result(value.begin(),
+                   value.begin() + std::min(half, value.size()));
+      trim(result);
+      return result;
+    };
+    auto high = [=](const Limbs &value) {
+      if (value.size() <= half) {
+        return Limbs{};
       }
+      return Limbs(value.begin() + half, value.end());
+    };
+    Limbs result(a.size() + b.size() + 1);
+    if (a.size() <= half || b.size() <= half) {
+      const Limbs &large = a.size() > b.size() ? a : b;
+      const Limbs &small = a.size() > b.size() ? b : a;
+      addShifted(result, mul(low(large), small), 0);
+      addShifted(result, mul(high(large), small), half);
+      trim(result);
+      return result;
     }
-    result = std::wstring(result.rbegin(), result.rend());
-    if (_negative) {
-      result = L"-" + result;
+    auto a0 = low(a);
+    auto a1 = high(a);
+    auto b0 = low(b);
+    auto b1 = high(b);
+    auto z0 = mul(a0, b0);
+    auto z2 = mul(a1, b1);
+    auto z1 = sub(sub(mul(add(a0, a1), add(b0, b1)), z0), z2);
+    addShifted(result, z0, 0);
+    addShifted(result, z1, half);
+    addShifted(result, z2, half * 2);
+    trim(result);
+    return result;
+  }
+
+  static Limbs divSmall(const Limbs &a, T divisor, T &remainder) {
+    Limbs result(a.size());
+    Wide rem = 0;
+    for (size_t index = a.size(); index > 0; index--) {
+      Wide cur = (rem << 64) | a[index - 1];
+      result[index - 1] = (T)(cur / divisor);
+      rem = cur % divisor;
     }
+    remainder = (T)rem;
+    trim(result);
     return result;
   }
 
-  std::optional<int64_t> toInt64() const {
-    int64_t result = 0;
-    uint32_t step = 0;
-    if (_data.size() == 1) {
-      return _data[0];
-    }
-    for (auto &item : _data) {
-      int64_t tmp = item;
-      tmp <<= step;
-      step += sizeof(T) * 8;
-      if (step > 63) {
-        return std::nullopt;
-      }
-      result |= tmp;
+  static void mulAddSmall(Limbs &a, T factor, T addend) {
+    T carry = addend;
+    for (auto &limb : a) {
+      Wide cur = (Wide)limb * factor + carry;
+      limb = (T)cur;
+      carry = (T)(cur >> 64);
     }
-    if (_negative) {
-      result = -result;
+    if (carry != 0) {
+      a.push_back(carry);
+    }
+  }
+
+  static Limbs shiftLeft(const Limbs &a, size_t bits) {
+    if (a.empty()) {
+      return {};
+    }
+    size_t limbs = bits / 64;
+    size_t offset = bits % 64;
+    Limbs result(a.size() + limbs + 1);
+    for (size_t index = 0; index < a.size(); index++) {
+      result[index + limbs] |= a[index] << offset;
+      if (offset != 0) {
+        result[index + limbs + 1] = a[index] >> (64 - offset);
+      }
     }
+    trim(result);
     return result;
   }
 
-  BigInt abs() const {
-    BigInt result = *this;
-    result._negative = true;
+  static Limbs shiftRight(const Limbs &a, size_t bits) {
+    size_t limbs = bits / 64;
+    size_t offset = bits % 64;
+    if (limbs >= a.size()) {
+      return {};
+    }
+    Limbs result(a.size() - limbs);
+    for (size_t index = 0; index < result.size(); index++) {
+      result[index] = a[index + limbs] >> offset;
+      if (offset != 0 && index + limbs + 1 < a.size()) {
+        result[index] |= a[index + limbs + 1] << (64 - offset);
+      }
+    }
+    trim(result);
     return result;
   }
 
-  BigInt uadd(const BigInt &another) const {
-    static uint64_t max = (uint64_t)((T)-1) + 1;
-    size_t index = 0;
-    uint64_t next = 0;
-    BigInt result;
-    while (next != 0 || _data.size() > index || another._data.size() > index) {
-      uint64_t val = next;
-      if (index < _data.size()) {
-        val += _data[index];
+  // Knuth, TAOCP vol. 2, 4.3.1, Algorithm D
+  static void divmod(const Limbs &u, const Limbs &v, Limbs &quotient,
+                     Limbs &remainder) {
+    if (compare(u, v) < 0) {
+      quotient.clear();
+      remainder = u;
+      return;
+    }
+    if (v.size() == 1) {
+      T rem = 0;
+      quotient = divSmall(u, v[0], rem);
+      remainder.clear();
+      if (rem != 0) {
+        remainder.push_back(rem);
       }
-      if (index < another._data.size()) {
-        val += another._data[index];
+      return;
+    }
+    size_t n = v.size();
+    size_t m = u.size();
+    int shift = __builtin_clzll(v.back());
+    Limbs vn = shiftLeft(v, shift);
+    Limbs un = shiftLeft(u, shift);
+    un.resize(m + 1);
+    quotient.assign(m - n + 1, 0);
+    for (size_t j = m - n + 1; j > 0; j--) {
+      size_t k = j - 1;
+      Wide num = ((Wide)un[k + n] << 64) | un[k + n - 1];
+      Wide qhat = num / vn[n - 1];
+      Wide rhat = num % vn[n - 1];
+      while ((qhat >> 64) != 0 ||
+             qhat * vn[n - 2] > ((rhat << 64) | un[k + n - 2])) {
+        qhat--;
+        rhat += vn[n - 1];
+        if ((rhat >> 64) != 0) {
+          break;
+        }
       }
-      if (index >= result._data.size()) {
-        result._data.push_back(0);
+      T borrow = 0;
+      T carry = 0;
+      for (size_t i = 0; i < n; i++) {
+        Wide product = qhat * vn[i] + carry;
+        carry = (T)(product >> 64);
+        Wide diff = (Wide)un[i + k] - (T)product - borrow;
+        un[i + k] = (T)diff;
+        borrow = (diff >> 64) ? 1 : 0;
       }
-      result._data[index] = (T)(val % max);
-      next = val / max;
-      index++;
+      Wide diff = (Wide)un[k + n] - carry - borrow;
+      un[k + n] = (T)diff;
+      quotient[k] = (T)qhat;
+      if ((diff >> 64) != 0) {
+        quotient[k]--;
+        T overflow = 0;
+        for (size_t i = 0; i < n; i++) {
+          Wide sum = (Wide)un[i + k] + vn[i] + overflow;
+          un[i + k] = (T)sum;
+          overflow = (T)(sum >> 64);
+        }
+        un[k + n] += overflow;
+      }
+    }
+    trim(quotient);
+    un.resize(n);
+    trim(un);
+    remainder = shiftRight(un, shift);
+  }
+
+  static const Limbs &decimalPower(std::vector<Limbs> &powers, size_t level) {
+    if (powers.empty()) {
+      powers.push_back({DECIMAL_BASE});
+    }
+    while (powers.size() <= level) {
+      powers.push_back(mul(powers.back(), powers.back()));
+    }
+    return powers[level];
+  }
+
+  // chunks are base 10^19 digits, most significant first
+  static Limbs fromDecimal(const std::vector<T> &chunks, size_t begin,
+                           size_t end, std::vector<Limbs> &powers) {
+    if (end - begin <= DECIMAL_THRESHOLD) {
+      Limbs result;
+      for (size_t index = begin; index < end; index++) {
+        mulAddSmall(result, DECIMAL_BASE, chunks[index]);
+      }
+      trim(result);
+      return result;
     }
+    size_t level = 0;
+    while (((size_t)2 << level) < end - begin) {
+      level++;
+    }
+    size_t middle = end - ((size_t)1 << level);
+    auto result = mul(fromDecimal(chunks, begin, middle, powers),
+                      decimalPower(powers, level));
+    auto low = fromDecimal(chunks, middle, end, powers);
+    result.resize(std::max(result.size(), low.size()) + 1);
+    addShifted(result, low, 0);
+    trim(result);
     return result;
   }
 
-  BigInt usub(const BigInt &another) const {
-    BigInt left = abs();
-    BigInt right = another.abs();
-    BigInt *a = &left;
-    BigInt *b = &right;
-    bool neg = false;
-    if (left > right) {
-      a = &right;
-      b = &left;
-      neg = true;
+  // appends the digits of value left padded with zeros to width,
+  // value must be less than powers[level]^2
+  static void toDecimal(const Limbs &value, const std::vector<Limbs> &powers,
+                        size_t level, size_t width, std::wstring &output) {
+    if (level == 0 || value.size() <= DECIMAL_THRESHOLD) {
+      std::wstring digits;
+      Limbs tmp = value;
+      while (!tmp.empty()) {
+        T chunk = 0;
+        tmp = divSmall(tmp, DECIMAL_BASE, chunk);
+        for (size_t index = 0;
+             index < DECIMAL_DIGITS && (chunk != 0 || !tmp.empty()); index++) {
+          digits.push_back(L'0' + chunk % 10);
+          chunk /= 10;
+        }
+      }
+      if (digits.length() < width) {
+        output.append(width - digits.length(), L'0');
+      }
+      output.append(digits.rbegin(), digits.rend());
+      return;
+    }
+    Limbs quotient;
+    Limbs remainder;
+    divmod(value, powers[level], quotient, remainder);
+    size_t lowWidth = DECIMAL_DIGITS << level;
+    if (quotient.empty() && width == 0) {
+      toDecimal(remainder, powers, level - 1, 0, output);
+      return;
+    }
+    toDecimal(quotient, powers, level - 1,
+              width > lowWidth ? width - lowWidth : 0, output);
+    toDecimal(remainder, powers, level - 1, lowWidth, output);
+  }
+
+  // two's complement limbs of a signed value, sign extended to size
+  Limbs toComplement(size_t size) const {
+    Limbs result = _data;
+    result.resize(size);
+    if (_negative) {
+      T carry = 1;
+      for (auto &limb : result) {
+        Wide sum = (Wide)(T)~limb + carry;
+        limb = (T)sum;
+        carry = (T)(sum >> 64);
+      }
     }
-    int64_t next = 0;
+    return result;
+  }
+
+  static BigInt fromComplement(Limbs data) {
     BigInt result;
-    result._data.clear();
-    for (size_t index = 0; index < a->_data.size(); index++) {
-      uint64_t pa = a->_data[index];
-      pa += next;
-      if (index < b->_data.size()) {
-        uint64_t pb = b->_data[index];
-        if (pa < pb) {
-          pa += 1 << sizeof(T) * 8;
-          next = -1;
+    if (!data.empty() && (data.back() >> 63) != 0) {
+      T carry = 1;
+      for (auto &limb : data) {
+        Wide sum = (Wide)(T)~limb + carry;
+        limb = (T)sum;
+        carry = (T)(sum >> 64);
+      }
+      result._negative = true;
+    }
+    trim(data);
+    result._data = std::move(data);
+    if (result._data.empty()) {
+      result._negative = false;
+    }
+    return result;
+  }
+
+  template <class F> BigInt bitwise(const BigInt &another, F op) const {
+    size_t size = std::max(_data.size(), another._data.size()) + 1;
+    auto a = toComplement(size);
+    auto b = another.toComplement(size);
+    for (size_t index = 0; index < size; index++) {
+      a[index] = op(a[index], b[index]);
+    }
+    return fromComplement(std::move(a));
+  }
+
+  size_t toShift() const {
+    if (_data.size() > 1) {
+      throw std::runtime_error("Maximum BigInt size exceeded");
+    }
+    return _data.empty() ? 0 : _data[0];
+  }
+
+  void normalize() {
+    trim(_data);
+    if (_data.empty()) {
+      _negative = false;
+    }
+  }
+
+public:
+  BigInt() : _negative(false) {}
+
+  BigInt(const BigInt &another)
+      : _data(another._data), _negative(another._negative) {}
+
+  BigInt(BigInt &&another)
+      : _data(std::move(another._data)), _negative(another._negative) {}
+
+  BigInt(int64_t number) : _negative(number < 0) {
+    uint64_t magnitude = number < 0 ? 0 - (uint64_t)number : number;
+    if (magnitude != 0) {
+      _data.push_back(magnitude);
+    }
+  }
+
+  BigInt(const std::wstring &source) : _negative(false) {
+    auto chr = source.c_str();
+    if (*chr == L'+') {
+      chr++;
+    } else if (*chr == L'-') {
+      _negative = true;
+      chr++;
+    }
+    auto end = source.c_str() + source.length();
+    size_t length = end - chr;
+    std::vector<T> chunks;
+    chunks.reserve(length / DECIMAL_DIGITS + 1);
+    size_t head = length % DECIMAL_DIGITS;
+    if (head == 0) {
+      head = DECIMAL_DIGITS;
+    }
+    while (chr != end) {
+      T chunk = 0;
+      for (auto next = chr + head; chr != next; chr++) {
+        if (*chr < '0' || *chr > '9') {
+          throw std::runtime_error("Cannot convert to a BigInt");
         }
-        result._data.push_back((T)(pa - pb));
-      } else {
-        result._data.push_back((T)pa);
+        chunk = chunk * 10 + (*chr - '0');
+      }
+      chunks.push_back(chunk);
+      head = DECIMAL_DIGITS;
+    }
+    std::vector<Limbs> powers;
+    _data = fromDecimal(chunks, 0, chunks.size(), powers);
+    normalize();
+  }
+
+  std::wstring toString() const {
+    if (_data.empty()) {
+      return L"0";
+    }
+    std::wstring result;
+    if (_negative) {
+      result.push_back(L'-');
+    }
+    std::vector<Limbs> powers = {{DECIMAL_BASE}};
+    while (powers.back().size() * 2 - 1 <= _data.size()) {
+      powers.push_back(mul(powers.back(), powers.back()));
+    }
+    toDecimal(_data, powers, powers.size() - 1, 0, result);
+    return result;
+  }
+
+  std::optional<int64_t> toInt64() const {
+    if (_data.empty()) {
+      return 0;
+    }
+    if (_data.size() > 1) {
+      return std::nullopt;
+    }
+    if (_negative) {
+      if (_data[0] > (uint64_t)INT64_MAX + 1) {
+        return std::nullopt;
       }
+      return (int64_t)(0 - _data[0]);
     }
-    while (result._data.size() > 1 && *result._data.rbegin() == 0) {
-      result._data.pop_back();
+    if (_data[0] > (uint64_t)INT64_MAX) {
+      return std::nullopt;
     }
-    result._negative = neg;
+    return (int64_t)_data[0];
+  }
+
+  BigInt abs() const {
+    BigInt result = *this;
+    result._negative = false;
     return result;
   }
 
   bool isNetative() const { return _negative; }
 
+  // bits of the magnitude, 0 for zero
+  size_t getBitLength() const {
+    if (_data.empty()) {
+      return 0;
+    }
+    return _data.size() * 64 - std::countl_zero(_data.back());
+  }
+
   BigInt &operator=(const BigInt &another) {
     if (this == &another) {
       return *this;
@@ -173,129 +516,60 @@ public:
     return *this;
   }
 
+  BigInt &operator=(BigInt &&another) {
+    _negative = another._negative;
+    _data = std::move(another._data);
+    return *this;
+  }
+
   BigInt operator+(const BigInt &another) const {
+    BigInt result;
     if (_negative == another._negative) {
-      BigInt result = uadd(another);
+      result._data = add(_data, another._data);
+      result._negative = _negative;
+    } else if (compare(_data, another._data) >= 0) {
+      result._data = sub(_data, another._data);
       result._negative = _negative;
-      return result;
     } else {
-      return *this - (-another);
+      result._data = sub(another._data, _data);
+      result._negative = another._negative;
     }
+    result.normalize();
+    return result;
   }
 
-  BigInt operator*(const BigInt &another) const {
+  BigInt operator-(const BigInt &another) const { return *this + (-another); }
 
-    static uint64_t max = (uint64_t)((T)-1) + 1;
+  BigInt operator*(const BigInt &another) const {
     BigInt result;
-    uint64_t rindex = 0;
-    for (auto &part : another._data) {
-      uint64_t next = 0;
-      for (size_t index = 0; index < _data.size(); index++) {
-        auto &src = _data[index];
-        if (index + rindex >= result._data.size()) {
-          result._data.push_back(0);
-        }
-        auto val = part * src + next;
-        result._data[index + rindex] += (T)(val % max);
-        next = val / max;
-      }
-      if (next > 0) {
-        result._data.push_back((T)(next));
-      }
-      rindex++;
-    }
-    while (result._data.size() > 1 && *result._data.rbegin() == 0) {
-      result._data.pop_back();
-    }
+    result._data = mul(_data, another._data);
     result._negative = _negative != another._negative;
+    result.normalize();
     return result;
   }
 
-  BigInt operator-(const BigInt &another) const {
-    if (_negative == another._negative) {
-      BigInt result = usub(another);
-      if (_negative) {
-        result._negative = !result._negative;
-      }
-      return result;
-    } else {
-      return *this + (-another);
-    }
-  }
-
   BigInt operator/(const BigInt &another) const {
-    if (another == 0) {
+    if (another._data.empty()) {
       throw std::runtime_error("Division by zero");
     }
-    if (another > *this) {
-      return 0;
-    }
-    if (another == *this) {
-      return 1;
-    }
-    size_t len = _data.size() - another._data.size();
-    BigInt next;
     BigInt result;
-    std::vector<T> rdata;
-    for (size_t index = 0; index <= len; index++) {
-      BigInt tmp;
-      tmp._data.clear();
-      std::vector<T> data;
-      for (size_t i = 0; i < another._data.size(); i++) {
-        data.push_back(_data[_data.size() - 1 - index - i]);
-      }
-      for (auto it = data.rbegin(); it != data.rend(); it++) {
-        tmp._data.push_back(*it);
-      }
-      tmp += next * (int64_t)std::pow(2, sizeof(T) * 8);
-      T v = 0;
-      while (tmp >= another) {
-        tmp -= another;
-        v++;
-      }
-      next = tmp;
-      rdata.push_back(v);
-    }
-    result._data.clear();
-    while (rdata.size() > 1 && *rdata.begin() == 0) {
-      rdata.erase(rdata.begin());
-    }
-    for (auto it = rdata.rbegin(); it != rdata.rend(); it++) {
-      result._data.push_back(*it);
-    }
+    Limbs remainder;
+    divmod(_data, another._data, result._data, remainder);
+    result._negative = _negative != another._negative;
+    result.normalize();
     return result;
   }
 
   BigInt operator%(const BigInt &another) const {
-    if (another == 0) {
+    if (another._data.empty()) {
       throw std::runtime_error("Division by zero");
     }
-    if (another > *this) {
-      return *this;
-    }
-    if (another == *this) {
-      return 0;
-    }
-    size_t len = _data.size() - another._data.size();
-    BigInt next;
-    for (size_t index = 0; index <= len; index++) {
-      BigInt tmp;
-      tmp._data.clear();
-      std::vector<T> data;
-      for (size_t i = 0; i < another._data.size(); i++) {
-        data.push_back(_data[_data.size() - 1 - index - i]);
-      }
-      for (auto it = data.rbegin(); it != data.rend(); it++) {
-        tmp._data.push_back(*it);
-      }
-      tmp += next * (int64_t)(std::pow(2, sizeof(T) * 8));
-      while (tmp >= another) {
-        tmp -= another;
-      }
-      next = tmp;
-    }
-    next._negative = _negative;
-    return next;
+    BigInt result;
+    Limbs quotient;
+    divmod(_data, another._data, quotient, result._data);
+    result._negative = _negative;
+    result.normalize();
+    return result;
   }
 
   BigInt operator+() const { return *this; }
@@ -303,245 +577,93 @@ public:
   BigInt operator-() const {
     BigInt result = *this;
     result._negative = !result._negative;
+    result.normalize();
     return result;
   }
 
-  BigInt operator~() const {
-    BigInt result = *this;
-    result += 1;
-    result = -result;
-    return result;
-  }
+  BigInt operator~() const { return -*this - 1; }
 
   bool operator>(const BigInt &another) const {
-
-    if (!_negative && another._negative) {
-      return true;
-    } else if (_negative && !another._negative) {
-      return false;
-    }
-    if (_data.size() > another._data.size()) {
-      return !_negative;
-    } else if (_data.size() < another._data.size()) {
-      return _negative;
-    }
-    for (size_t index = 0; index < _data.size(); index++) {
-      if (_data[index] > another._data[index]) {
-        return !_negative;
-      } else if (_data[index] < another._data[index]) {
-        return _negative;
-      }
+    if (_negative != another._negative) {
+      return another._negative;
     }
-    return false;
+    int result = compare(_data, another._data);
+    return _negative ? result < 0 : result > 0;
   }
 
-  bool operator<(const BigInt &another) const {
-    if (!_negative && another._negative) {
-      return false;
-    } else if (_negative && !another._negative) {
-      return true;
-    }
-    if (_data.size() > another._data.size()) {
-      return _negative;
-    } else if (another._data.size() > _data.size()) {
-      return !_negative;
-    }
-    for (size_t index = 0; index < _data.size(); index++) {
-      if (_data[index] > another._data[index]) {
-        return _negative;
-      } else if (_data[index] < another._data[index]) {
-        return !_negative;
-      }
-    }
-    return false;
-  }
+  bool operator<(const BigInt &another) const { return another > *this; }
 
-  bool operator>=(const BigInt &another) const {
-    if (!_negative && another._negative) {
-      return true;
-    } else if (_negative && !another._negative) {
-      return false;
-    }
-    if (_data.size() > another._data.size()) {
-      return !_negative;
-    } else if (_data.size() < another._data.size()) {
-      return _negative;
-    }
-    for (size_t index = 0; index < _data.size(); index++) {
-      if (_data[index] > another._data[index]) {
-        return !_negative;
-      } else if (_data[index] < another._data[index]) {
-        return _negative;
-      }
-    }
-    return true;
-  }
+  bool operator>=(const BigInt &another) const { return !(another > *this); }
 
-  bool operator<=(const BigInt &another) const {
-    if (!_negative && another._negative) {
-      return false;
-    } else if (_negative && !another._negative) {
-      return true;
-    }
-    if (_data.size() > another._data.size()) {
-      return _negative;
-    } else if (_data.size() < another._data.size()) {
-      return !_negative;
-    }
-    for (size_t index = 0; index < _data.size(); index++) {
-      if (_data[index] > another._data[index]) {
-        return _negative;
-      } else if (_data[index] < another._data[index]) {
-        return !_negative;
-      }
-    }
-    return true;
-  }
+  bool operator<=(const BigInt &another) const { return !(*this > another); }
 
   bool operator==(const BigInt &another) const {
-    if (_negative != another._negative) {
-      return false;
-    }
-    if (_data.size() != another._data.size()) {
-      return false;
-    }
-    for (size_t index = 0; index < _data.size(); index++) {
-      if (_data[index] != another._data[index]) {
-        return false;
-      }
-    }
-    return true;
+    return _negative == another._negative && _data == another._data;
   }
 
-  bool operator!=(const BigInt &another) const {
-    if (_negative != another._negative) {
-      return true;
-    }
-    if (_data.size() != another._data.size()) {
-      return true;
-    }
-    for (size_t index = 0; index < _data.size(); index++) {
-      if (_data[index] != another._data[index]) {
-        return true;
-      }
-    }
-    return false;
-  }
+  bool operator!=(const BigInt &another) const { return !(*this == another); }
 
   BigInt pow(const BigInt &another) const {
+    if (another._negative) {
+      throw std::runtime_error("Exponent must be non-negative");
+    }
     BigInt result = 1;
-    for (BigInt i = 0; i < another; i += 1) {
-      result *= *this;
+    BigInt base = *this;
+    for (size_t index = 0; index < another._data.size(); index++) {
+      T bits = another._data[index];
+      bool last = index + 1 == another._data.size();
+      for (int bit = 0; bit < 64 && (!last || bits != 0); bit++) {
+        if (bits & 1) {
+          result *= base;
+        }
+        bits >>= 1;
+        if (!last || bits != 0) {
+          base *= base;
+        }
+      }
     }
     return result;
   }
 
   BigInt operator<<(const BigInt &another) const {
-    BigInt result = *this;
-    for (BigInt i = 0; i < another; i += 1) {
-      result *= 2;
+    if (another._negative) {
+      return *this >> -another;
     }
+    BigInt result;
+    result._data = shiftLeft(_data, another.toShift());
+    result._negative = _negative;
+    result.normalize();
     return result;
   }
 
   BigInt operator>>(const BigInt &another) const {
-    BigInt result = *this;
-    for (BigInt i = 0; i < another; i += 1) {
-      result /= 2;
+    if (another._negative) {
+      return *this << -another;
+    }
+    if (another._data.size() > 1) {
+      return _negative ? BigInt(-1) : BigInt();
+    }
+    size_t bits = another.toShift();
+    BigInt result;
+    result._data = shiftRight(_data, bits);
+    result._negative = _negative;
+    result.normalize();
+    if (_negative && shiftLeft(result._data, bits) != _data) {
+      result -= 1;
     }
     return result;
   }
 
   BigInt operator&(const BigInt &another) const {
-    BigInt result;
-    result._data.clear();
-    size_t index = 0;
-    BigInt a = *this;
-    BigInt b = another;
-    BigInt max;
-    max._data.clear();
-    while (a._data.size() > index || b._data.size() > index) {
-      max._data.push_back((T)-1);
-      index++;
-    }
-    if (a._negative) {
-      a = max + 1 + a;
-    }
-    if (b._negative) {
-      b = max + 1 + b;
-    }
-    index = 0;
-    while (a._data.size() > index || b._data.size() > index) {
-      T val1 = 0;
-      T val2 = 0;
-      if (index < a._data.size()) {
-        val1 = a._data[index];
-      }
-      if (index < b._data.size()) {
-        val2 = b._data[index];
-      }
-      result._data.push_back(val1 & val2);
-      index++;
-    }
-    while (!*result._data.rbegin()) {
-      result._data.pop_back();
-    }
-    if (result._data.empty()) {
-      result._data.push_back(0);
-    }
-    if (_negative && another._negative) {
-      result = max + 1 - result;
-    }
-    result._negative = _negative && another._negative;
-    return result;
+    return bitwise(another, [](T a, T b) -> T { return a & b; });
   }
 
   BigInt operator|(const BigInt &another) const {
-    BigInt result;
-    result._data.clear();
-    size_t index = 0;
-    BigInt a = *this;
-    BigInt b = another;
-    BigInt max;
-    max._data.clear();
-    while (a._data.size() > index || b._data.size() > index) {
-      max._data.push_back((T)-1);
-      index++;
-    }
-    if (a._negative) {
-      a = max + 1 + a;
-    }
-    if (b._negative) {
-      b = max + 1 + b;
-    }
-    index = 0;
-    while (a._data.size() > index || b._data.size() > index) {
-      T val1 = 0;
-      T val2 = 0;
-      if (index < a._data.size()) {
-        val1 = a._data[index];
-      }
-      if (index < b._data.size()) {
-        val2 = b._data[index];
-      }
-      result._data.push_back(val1 | val2);
-      index++;
-    }
-    while (!*result._data.rbegin()) {
-      result._data.pop_back();
-    }
-    if (result._data.empty()) {
-      result._data.push_back(0);
-    }
-    if (_negative || another._negative) {
-      result = max + 1 - result;
-    }
-    result._negative = _negative || another._negative;
-    return result;
+    return bitwise(another, [](T a, T b) -> T { return a | b; });
   }
 
   BigInt operator^(const BigInt &another) const {
-    return (*this & ~another) | (~*this & another);
+    return bitwise(another, [](T a, T b) -> T { return a ^ b; });
   }
 
   BigInt &operator*=(const BigInt &another) { return *this = *this * another; }
@@ -0,0 +1,97 @@
+#pragma once
+#include "JSAllocator.hpp"
+#include <array>
+#include <cstddef>
+#include <new>
+#include <vector>
+
+// bump allocator for objects that die together, such as the nodes of one
+// parse: reset releases everything at once. Objects still run their
+// destructors through dispose before the reset. Freed small objects are
+// kept on per-size lists and handed out again, since a backtracking parse
+// discards most of what it allocates.
+class JSArenaAllocator : public JSAllocator {
+public:
+  static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+  static constexpr size_t ALIGNMENT = alignof(std::max_align_t);
+
+  static constexpr size_t MAX_RECYCLED_SIZE = 1024;
+
+private:
+  struct Block {
+    char *data;
+    size_t size;
+  };
+
+  std::vector<Block> _blocks;
+  size_t _current{};
+  size_t _used{};
+  std::array<void *, MAX_RECYCLED_SIZE / ALIGNMENT + 1> _recycled{};
+
+  void release(size_t keep) {
+    while (_blocks.size() > keep) {
+      ::operator delete(_blocks.back().data);
+      _blocks.pop_back();
+    }
+  }
+
+  void *allocBlock(size_t size) {
+    while (_current < _blocks.size() &&
+           _used + size > _blocks[_current].size) {
+      _current++;
+      _used = 0;
+    }
+    if (_current == _blocks.size()) {
+      auto length = size > BLOCK_SIZE ? size : BLOCK_SIZE;
+      _blocks.push_back({(char *)::operator new(length), length});
+      _used = 0;
+    }
+    auto buf = _blocks[_current].data + _used;
+    _used += size;
+    return buf;
+  }
+
+public:
+  JSArenaAllocator() {}
+
+  ~JSArenaAllocator() override { release(0); }
+
+  void *alloc(size_t size) override {
+    size = (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    if (size <= MAX_RECYCLED_SIZE) {
+      auto &head = _recycled[size / ALIGNMENT];
+      if (head) {
+        auto buf = head;
+        head = *(void **)buf;
+        return buf;
+      }
+    }
+    auto buf = (char *)allocBlock(size + ALIGNMENT);
+    *(size_t *)buf = size;
+    return buf + ALIGNMENT;
+  }
+
+  void free(void *buf) override {
+    auto size = *(size_t *)((char *)buf - ALIGNMENT);
+    if (size <= MAX_RECYCLED_SIZE) {
+      auto &head = _recycled[size / ALIGNMENT];
+      *(void **)buf = head;
+      head = buf;
+    }
+  }
+
+  // keeps the first block so repeated parses do not hit malloc again
+  void reset() {
+    release(_blocks.empty() ? 0 : 1);
+    if (!_blocks.empty() && _blocks[0].size != BLOCK_SIZE) {
+      release(0);
+    }
+    _current = 0;
+    _used = 0;
+    _recycled.fill(nullptr);
+  }
+
+  size_t getBlockCount() const { return _blocks.size(); }
+
+};
@@ -17,7 +17,7 @@ public:
       auto ins = allocator->create<T>();
       store[name] = ins;
     }
-    auto ins = dynamic_cast<T *>(store.at(name));
+    auto ins = static_cast<T *>(store.at(name));
     return ins;
   }
 
@@ -27,7 +27,7 @@ public:
     if (!store.contains(name)) {
       return nullptr;
     }
-    auto ins = dynamic_cast<T *>(store.at(name));
+    auto ins = static_cast<T *>(store.at(name));
     return ins;
   }
 };
\ No newline at end of file
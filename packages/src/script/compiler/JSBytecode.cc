@@ -0,0 +1,186 @@
+#include "script/compiler/JSBytecode.hpp"
+#include "script/compiler/JSProgram.hpp"
+#include <iterator>
+#include <utility>
+
+static constexpr const wchar_t *OPERATOR_NAMES[] = {
+    L"BEGIN", L"END", L"PUSH", L"POP", L"PUSH_VALUE", L"NIL", L"UNDEFINED",
+    L"TRUE", L"FALSE", L"REGEX", L"CLASS", L"LOAD", L"STORE", L"REF", L"STR",
+    L"BIGINT", L"VAR", L"CONST", L"LET", L"THIS", L"OBJECT", L"ARRAY",
+    L"SUPER_CALL", L"SET_FUNCTION_NAME", L"FUNCTION", L"ASYNCFUNCTION",
+    L"ARROW", L"ASYNCARROW", L"GENERATOR", L"ASYNCGENERATOR", L"ENABLE",
+    L"DISABLE", L"PUSH_BACK", L"GET_FIELD", L"SET_FIELD",
+    L"SET_ACCESSOR_GETTER", L"SET_ACCESSOR_SETTER", L"SET_METHOD",
+    L"SET_PROP_FIELD", L"SET_PROP_METHOD", L"SET_PROP_ACCESSOR_GETTER",
+    L"SET_PROP_ACCESSOR_SETTER", L"GET_PRIVATE_FIELD", L"SET_PRIVATE_FIELD",
+    L"SET_PRIVATE_ACCESSOR_GETTER", L"SET_PRIVATE_ACCESSOR_SETTER",
+    L"SET_PRIVATE_METHOD", L"SET_PRIVATE_PROP_FIELD",
+    L"SET_PRIVATE_PROP_ACCESSOR_GETTER", L"SET_PRIVATE_PROP_ACCESSOR_SETTER",
+    L"SET_PRIVATE_PROP_METHOD", L"GET_KEYS", L"SET_SUPER_FIELD",
+    L"GET_SUPER_FIELD", L"SET_INITIALIZER", L"SET_PRIVATE_INITIALIZER",
+    L"CALL", L"MEMBER_CALL", L"PRIVATE_MEMBER_CALL", L"VOID", L"TYPEOF",
+    L"NEW", L"DELETE", L"RET", L"YIELD", L"AWAIT", L"THROW", L"YIELD_DELEGATE",
+    L"TRY_BEGIN", L"TRY_END", L"ON_FINISH", L"ON_ERROR", L"DEFER",
+    L"BREAK_LABEL_BEGIN", L"CONTINUE_LABEL_BEGIN", L"SET_LABELE_ADDRESS",
+    L"LABEL_END", L"BREAK", L"CONTINUE", L"JMP", L"JTRUE", L"JFALSE", L"JNULL",
+    L"JNOT_NULL", L"UPLUS", L"UNEG", L"ADD", L"CONCAT", L"SUB", L"DIV", L"MUL",
+    L"MOD", L"POW", L"AND", L"OR", L"NOT", L"XOR", L"SHR", L"SHL", L"USHR",
+    L"LNOT", L"EQ", L"SEQ", L"NE", L"SNE", L"GT", L"LT", L"GE", L"LE", L"INC",
+    L"DEC", L"UPDATE_INC", L"UPDATE_DEC", L"NEXT", L"AWAIT_NEXT", L"SPREAD",
+    L"MERGE", L"ITERATOR", L"OBJECT_SPREAD", L"ARRAY_SPREAD", L"EMPTY_CHECK",
+    L"ARGUMENT_SPREAD", L"HLT", L"DEBUGGER", L"WITH", L"IMPORT", L"EXPORT",
+    L"EXPORT_ALL", L"ASSERT", L"LAZY", L"LOAD_NAN", L"LOAD_INFINITY",
+};
+
+static constexpr size_t OPERATOR_COUNT = std::size(OPERATOR_NAMES);
+
+static_assert(OPERATOR_COUNT == (size_t)JS_OPERATOR::LOAD_INFINITY + 1,
+              "every operator needs a name");
+
+JS_OPERAND_TYPE JSBytecode::getOperandType(const JS_OPERATOR &opt) {
+  switch (opt) {
+  case JS_OPERATOR::PUSH:
+    return JS_OPERAND_TYPE::NUMBER;
+  case JS_OPERATOR::PUSH_VALUE:
+  case JS_OPERATOR::NEW:
+  case JS_OPERATOR::CONCAT:
+  case JS_OPERATOR::SPREAD:
+  case JS_OPERATOR::OBJECT_SPREAD:
+    return JS_OPERAND_TYPE::COUNT;
+  case JS_OPERATOR::LOAD:
+  case JS_OPERATOR::STORE:
+  case JS_OPERATOR::REF:
+  case JS_OPERATOR::VAR:
+  case JS_OPERATOR::CONST:
+  case JS_OPERATOR::LET:
+  case JS_OPERATOR::SET_FUNCTION_NAME:
+  case JS_OPERATOR::ENABLE:
+  case JS_OPERATOR::DISABLE:
+  case JS_OPERATOR::BREAK_LABEL_BEGIN:
+  case JS_OPERATOR::CONTINUE_LABEL_BEGIN:
+  case JS_OPERATOR::BREAK:
+  case JS_OPERATOR::CONTINUE:
+  case JS_OPERATOR::IMPORT:
+  case JS_OPERATOR::EXPORT:
+  case JS_OPERATOR::ASSERT:
+    return JS_OPERAND_TYPE::IDENTIFIER;
+  case JS_OPERATOR::STR:
+    return JS_OPERAND_TYPE::STRING;
+  case JS_OPERATOR::REGEX:
+    return JS_OPERAND_TYPE::REGEX;
+  case JS_OPERATOR::BIGINT:
+    return JS_OPERAND_TYPE::BIGINT;
+  case JS_OPERATOR::FUNCTION:
+  case JS_OPERATOR::ASYNCFUNCTION:
+  case JS_OPERATOR::ARROW:
+  case JS_OPERATOR::ASYNCARROW:
+  case JS_OPERATOR::GENERATOR:
+  case JS_OPERATOR::ASYNCGENERATOR:
+  case JS_OPERATOR::SET_INITIALIZER:
+  case JS_OPERATOR::SET_PRIVATE_INITIALIZER:
+  case JS_OPERATOR::SET_LABELE_ADDRESS:
+  case JS_OPERATOR::ON_FINISH:
+  case JS_OPERATOR::ON_ERROR:
+  case JS_OPERATOR::JMP:
+  case JS_OPERATOR::JTRUE:
+  case JS_OPERATOR::JFALSE:
+  case JS_OPERATOR::JNULL:
+  case JS_OPERATOR::JNOT_NULL:
+    return JS_OPERAND_TYPE::ADDRESS;
+  case JS_OPERATOR::LAZY:
+    return JS_OPERAND_TYPE::LAZY;
+  default:
+    return JS_OPERAND_TYPE::NONE;
+  }
+}
+
+const wchar_t *JSBytecode::getOperatorName(const JS_OPERATOR &opt) {
+  if ((size_t)opt >= OPERATOR_COUNT) {
+    return L"UNKNOWN";
+  }
+  return OPERATOR_NAMES[(size_t)opt];
+}
+
+bool JSBytecode::verify(const JSProgram &program, size_t begin,
+                        size_t *fault) {
+  auto codes = program.codes.data();
+  auto end = program.codes.size();
+  std::vector<bool> boundaries(end - begin + 1, false);
+  std::vector<std::pair<size_t, size_t>> jumps;
+  auto reject = [&](size_t offset) {
+    if (fault) {
+      *fault = offset;
+    }
+    return false;
+  };
+  auto offset = begin;
+  while (offset < end) {
+    auto start = offset;
+    boundaries[start - begin] = true;
+    auto opt = (JS_OPERATOR)codes[offset++];
+    if ((size_t)opt >= OPERATOR_COUNT) {
+      return reject(start);
+    }
+    auto type = getOperandType(opt);
+    if (type == JS_OPERAND_TYPE::NONE) {
+      continue;
+    }
+    if (type == JS_OPERAND_TYPE::NUMBER) {
+      if (end - offset < NUMBER_SIZE) {
+        return reject(start);
+      }
+      offset += NUMBER_SIZE;
+      continue;
+    }
+    if (type == JS_OPERAND_TYPE::ADDRESS || type == JS_OPERAND_TYPE::LAZY) {
+      if (end - offset < FIXED_SIZE) {
+        return reject(start);
+      }
+      if (type == JS_OPERAND_TYPE::LAZY) {
+        if (readFixed(codes, offset) >= program.lazyFunctions.size()) {
+          return reject(start);
+        }
+      } else {
+        jumps.push_back({start, readAddress(codes, offset)});
+      }
+      continue;
+    }
+    size_t length = 0;
+    while (length < MAX_VARINT_SIZE && offset + length < end &&
+           (codes[offset + length] & 0x80)) {
+      length++;
+    }
+    if (length == MAX_VARINT_SIZE || offset + length == end) {
+      return reject(start);
+    }
+    auto value = readVarint(codes, offset);
+    size_t size = 0;
+    switch (type) {
+    case JS_OPERAND_TYPE::IDENTIFIER:
+      size = program.identifiers.size();
+      break;
+    case JS_OPERAND_TYPE::STRING:
+      size = program.stringValues.size();
+      break;
+    case JS_OPERAND_TYPE::REGEX:
+      size = program.regexes.size();
+      break;
+    case JS_OPERAND_TYPE::BIGINT:
+      size = program.bigints.size();
+      break;
+    default:
+      size = SIZE_MAX;
+      break;
+    }
+    if (value >= size) {
+      return reject(start);
+    }
+  }
+  boundaries[end - begin] = true;
+  for (auto &[start, address] : jumps) {
+    if (address < begin || address > end || !boundaries[address - begin]) {
+      return reject(start);
+    }
+  }
+  return true;
+}
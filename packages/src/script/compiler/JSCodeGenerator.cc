@@ -5,7 +5,7 @@ JSNode *JSCodeGenerator::resolveStore(const std::wstring &source, JSNode *node,
                                       JSProgram &program) {
   if (is(node, JS_NODE_TYPE::LITERAL_IDENTITY)) {
     pushOperator(program, JS_OPERATOR::STORE);
-    pushString(program, node->location.get(source));
+    pushIdentifier(program, node->location.get(source));
   } else if (is(node, JS_NODE_TYPE::EXPRESSION_MEMBER)) {
     auto expression = unwrap(node)->cast<JSMemberExpressionNode>();
     pushOperator(program, JS_OPERATOR::PUSH_VALUE);
@@ -108,7 +108,7 @@ JSNode *JSCodeGenerator::resolveStore(const std::wstring &source, JSNode *node,
         if (err) {
           return err;
         }
-        *(size_t *)(program.codes.data() + address) = program.codes.size();
+        setAddress(program, address, program.codes.size());
       }
       if (field->alias) {
         auto err = resolveStore(source, field->alias, program);
@@ -162,7 +162,7 @@ JSNode *JSCodeGenerator::resolveStore(const std::wstring &source, JSNode *node,
             if (err) {
               return err;
             }
-            *(size_t *)(program.codes.data() + address) = program.codes.size();
+            setAddress(program, address, program.codes.size());
           }
           auto err = resolveStore(source, field->alias, program);
           if (err) {
@@ -185,10 +185,9 @@ JSNode *JSCodeGenerator::resolveStore(const std::wstring &source, JSNode *node,
 void JSCodeGenerator::resolveExport(const std::wstring &source, JSNode *node,
                                     JSProgram &program) {
   if (is(node, JS_NODE_TYPE::LITERAL_IDENTITY)) {
-    pushOperator(program, JS_OPERATOR::LOAD);
-    pushString(program, node->location.get(source));
+    pushLoad(program, node->location.get(source));
     pushOperator(program, JS_OPERATOR::EXPORT);
-    pushString(program, node->location.get(source));
+    pushIdentifier(program, node->location.get(source));
     pushOperator(program, JS_OPERATOR::POP);
   } else if (is(node, JS_NODE_TYPE::PATTERN_OBJECT)) {
     auto expression = node->cast<JSObjectPatternNode>();
@@ -377,11 +376,8 @@ JSNode *JSCodeGenerator::resolveMemberChain(const std::wstring &source,
     } else {
       pushOperator(program, JS_OPERATOR::CALL);
     }
-    auto addr = program.codes.size();
-    program.stacks[addr] = {
-        .position = callee->location.end,
-        .filename = program.filename,
-    };
+    program.positions.push(program.codes.size(), callee->location.end.line,
+                           callee->location.end.column);
   } else if (is(node, JS_NODE_TYPE::EXPRESSION_GROUP)) {
     auto expression = node->cast<JSGroupExpressionNode>();
     return resolveMemberChain(source, expression->expression, program,
@@ -394,28 +390,30 @@ JSNode *JSCodeGenerator::resolveMemberChain(const std::wstring &source,
 
 std::unordered_map<JSNode *, size_t>
 JSCodeGenerator::beginScope(const std::wstring &source, JSNode *node,
-                            JSProgram &program) {
+                            JSProgram &program, bool open) {
   std::vector<JSLexDeclaration> functions;
   std::unordered_map<JSNode *, size_t> ctx;
-  pushOperator(program, JS_OPERATOR::BEGIN);
+  if (open) {
+    pushOperator(program, JS_OPERATOR::BEGIN);
+  }
   ++_scope;
   for (auto declar : node->scope->declarations) {
     switch (declar.type) {
     case JS_DECLARATION_TYPE::VAR:
       pushOperator(program, JS_OPERATOR::VAR);
-      pushString(program, declar.name);
+      pushIdentifier(program, declar.name);
       break;
     case JS_DECLARATION_TYPE::CONST:
       pushOperator(program, JS_OPERATOR::CONST);
-      pushString(program, declar.name);
+      pushIdentifier(program, declar.name);
       break;
     case JS_DECLARATION_TYPE::LET:
       pushOperator(program, JS_OPERATOR::LET);
-      pushString(program, declar.name);
+      pushIdentifier(program, declar.name);
       break;
     case JS_DECLARATION_TYPE::FUNCTION: {
       pushOperator(program, JS_OPERATOR::VAR);
-      pushString(program, declar.name);
+      pushIdentifier(program, declar.name);
       functions.push_back(declar);
     } break;
     }
@@ -438,13 +436,13 @@ JSCodeGenerator::beginScope(const std::wstring &source, JSNode *node,
     ctx[declar.declaration] = program.codes.size();
     pushAddress(program, 0);
     pushOperator(program, JS_OPERATOR::SET_FUNCTION_NAME);
-    pushString(program, declar.name);
+    pushIdentifier(program, declar.name);
     for (auto ref : func->closure) {
       pushOperator(program, JS_OPERATOR::REF);
-      pushString(program, ref);
+      pushIdentifier(program, ref);
     }
     pushOperator(program, JS_OPERATOR::STORE);
-    pushString(program, declar.name);
+    pushIdentifier(program, declar.name);
     pushOperator(program, JS_OPERATOR::POP);
   }
   return ctx;
@@ -458,19 +456,30 @@ JSNode *JSCodeGenerator::endScope(const std::wstring &source, JSNode *node,
     auto address = program.codes.size();
     pushAddress(program, 0);
     for (auto [declar, addr] : ctx) {
-      *(size_t *)(program.codes.data() + addr) = program.codes.size();
-      auto err = resolveFunctionDeclaration(source, (JSNode *)declar, program);
+      setAddress(program, addr, program.codes.size());
+      auto err = resolveLazyFunction(source, (JSNode *)declar, program);
       if (err) {
         return err;
       }
     }
-    *(size_t *)(program.codes.data() + address) = program.codes.size();
+    setAddress(program, address, program.codes.size());
   }
   --_scope;
   pushOperator(program, JS_OPERATOR::END);
   return nullptr;
 }
 
+JSNode *JSCodeGenerator::resolveChunk(const std::wstring &source,
+                                      JSNode *node, JSProgram &program,
+                                      bool first) {
+  auto ctx = beginScope(source, node, program, first);
+  auto err = resolveProgram(source, node, program);
+  if (err) {
+    return err;
+  }
+  return endScope(source, node, program, ctx);
+}
+
 JSNode *JSCodeGenerator::resolveNode(const std::wstring &source, JSNode *node,
                                      JSProgram &program) {
   switch (node->type) {
@@ -647,7 +656,7 @@ JSNode *JSCodeGenerator::resolveFunctionDeclaration(const std::wstring &source,
         if (err) {
           return err;
         }
-        *(size_t *)(program.codes.data() + address) = program.codes.size();
+        setAddress(program, address, program.codes.size());
       }
       auto err = resolveStore(source, argument->identifier, program);
       if (err) {
@@ -671,6 +680,24 @@ JSNode *JSCodeGenerator::resolveFunctionDeclaration(const std::wstring &source,
   return nullptr;
 }
 
+JSNode *JSCodeGenerator::resolveLazyFunction(const std::wstring &source,
+                                             JSNode *node,
+                                             JSProgram &program) {
+  if (!_lazy) {
+    return resolveFunctionDeclaration(source, node, program);
+  }
+  auto func = node->cast<JSFunctionBaseNode>();
+  program.lazyFunctions.push_back({
+      .offset = node->location.start.offset,
+      .arrow = node->type == JS_NODE_TYPE::DECLARATION_ARROW_FUNCTION,
+      .closure = {func->closure.begin(), func->closure.end()},
+  });
+  program.lazyPending++;
+  pushOperator(program, JS_OPERATOR::LAZY);
+  JSBytecode::pushFixed(program.codes, program.lazyFunctions.size() - 1);
+  return nullptr;
+}
+
 JSNode *JSCodeGenerator::resolveFunctionBodyDeclaration(
     const std::wstring &source, JSNode *node, JSProgram &program) {
   auto body = node->cast<JSFunctionBodyDeclarationNode>();
@@ -680,7 +707,7 @@ JSNode *JSCodeGenerator::resolveFunctionBodyDeclaration(
     str = str.substr(1, str.size() - 2);
     directives.push_back(str);
     pushOperator(program, JS_OPERATOR::ENABLE);
-    pushString(program, str);
+    pushIdentifier(program, str);
   }
   for (auto &statement : body->statements) {
     auto err = resolve(source, statement, program);
@@ -704,7 +731,7 @@ JSNode *JSCodeGenerator::resolveImportDeclaration(const std::wstring &source,
   auto str = declaration->source->location.get(source);
   str = str.substr(1, str.length() - 2);
   pushOperator(program, JS_OPERATOR::IMPORT);
-  pushString(program, str);
+  pushIdentifier(program, str);
   for (auto attr : declaration->attributes) {
     auto attribute = attr->cast<JSImportAttributeNode>();
     auto err = resolve(source, attribute->value, program);
@@ -712,7 +739,7 @@ JSNode *JSCodeGenerator::resolveImportDeclaration(const std::wstring &source,
       return err;
     }
     pushOperator(program, JS_OPERATOR::ASSERT);
-    pushString(program, attribute->key->location.get(source));
+    pushIdentifier(program, attribute->key->location.get(source));
   }
   for (auto specifier : declaration->specifiers) {
     if (specifier->type == JS_NODE_TYPE::IMPORT_DEFAULT) {
@@ -723,13 +750,13 @@ JSNode *JSCodeGenerator::resolveImportDeclaration(const std::wstring &source,
       pushUint32(program, 1);
       pushOperator(program, JS_OPERATOR::GET_FIELD);
       pushOperator(program, JS_OPERATOR::STORE);
-      pushString(program, s->identifier->location.get(source));
+      pushIdentifier(program, s->identifier->location.get(source));
     } else if (specifier->type == JS_NODE_TYPE::IMPORT_NAMESPACE) {
       auto s = specifier->cast<JSImportNamespaceNode>();
       pushOperator(program, JS_OPERATOR::PUSH_VALUE);
       pushUint32(program, 0);
       pushOperator(program, JS_OPERATOR::STORE);
-      pushString(program, s->alias->location.get(source));
+      pushIdentifier(program, s->alias->location.get(source));
     } else if (specifier->type == JS_NODE_TYPE::IMPORT_SPECIFIER) {
       auto s = specifier->cast<JSImportSpecifierNode>();
       pushOperator(program, JS_OPERATOR::STR);
@@ -739,9 +766,9 @@ JSNode *JSCodeGenerator::resolveImportDeclaration(const std::wstring &source,
       pushOperator(program, JS_OPERATOR::GET_FIELD);
       pushOperator(program, JS_OPERATOR::STORE);
       if (s->alias) {
-        pushString(program, s->alias->location.get(source));
+        pushIdentifier(program, s->alias->location.get(source));
       } else {
-        pushString(program, s->identifier->location.get(source));
+        pushIdentifier(program, s->identifier->location.get(source));
       }
     }
   }
@@ -757,7 +784,7 @@ JSNode *JSCodeGenerator::resolveExportDeclaration(const std::wstring &source,
     auto str = declaration->source->location.get(source);
     str = str.substr(1, str.length() - 2);
     pushOperator(program, JS_OPERATOR::IMPORT);
-    pushString(program, str);
+    pushIdentifier(program, str);
     for (auto attr : declaration->attributes) {
       auto attribute = attr->cast<JSImportAttributeNode>();
       auto err = resolve(source, attribute->value, program);
@@ -765,14 +792,14 @@ JSNode *JSCodeGenerator::resolveExportDeclaration(const std::wstring &source,
         return err;
       }
       pushOperator(program, JS_OPERATOR::ASSERT);
-      pushString(program, attribute->key->location.get(source));
+      pushIdentifier(program, attribute->key->location.get(source));
     }
     for (auto specifier : declaration->specifiers) {
       if (specifier->type == JS_NODE_TYPE::EXPORT_NAMESPACE) {
         auto s = specifier->cast<JSExportNamespaceNode>();
         if (s->alias) {
           pushOperator(program, JS_OPERATOR::EXPORT);
-          pushString(program, s->alias->location.get(source));
+          pushIdentifier(program, s->alias->location.get(source));
         } else {
           pushOperator(program, JS_OPERATOR::EXPORT_ALL);
         }
@@ -785,9 +812,9 @@ JSNode *JSCodeGenerator::resolveExportDeclaration(const std::wstring &source,
         pushOperator(program, JS_OPERATOR::GET_FIELD);
         pushOperator(program, JS_OPERATOR::EXPORT);
         if (s->alias) {
-          pushString(program, s->alias->location.get(source));
+          pushIdentifier(program, s->alias->location.get(source));
         } else {
-          pushString(program, s->identifier->location.get(source));
+          pushIdentifier(program, s->identifier->location.get(source));
         }
       }
     }
@@ -801,16 +828,15 @@ JSNode *JSCodeGenerator::resolveExportDeclaration(const std::wstring &source,
           return err;
         }
         pushOperator(program, JS_OPERATOR::EXPORT);
-        pushString(program, L"default");
+        pushIdentifier(program, L"default");
       } else if (s->type == JS_NODE_TYPE::EXPORT_SPECIFIER) {
         auto specifier = s->cast<JSExportSpecifierNode>();
-        pushOperator(program, JS_OPERATOR::LOAD);
-        pushString(program, specifier->identifier->location.get(source));
+        pushLoad(program, specifier->identifier->location.get(source));
         pushOperator(program, JS_OPERATOR::EXPORT);
         if (specifier->alias) {
-          pushString(program, specifier->alias->location.get(source));
+          pushIdentifier(program, specifier->alias->location.get(source));
         } else {
-          pushString(program, specifier->identifier->location.get(source));
+          pushIdentifier(program, specifier->identifier->location.get(source));
         }
       } else if (s->type == JS_NODE_TYPE::EXPORT_NAMED) {
         auto specifier = s->cast<JSExportNamedNode>();
@@ -821,16 +847,14 @@ JSNode *JSCodeGenerator::resolveExportDeclaration(const std::wstring &source,
         auto declaration = specifier->declaration;
         if (declaration->type == JS_NODE_TYPE::DECLARATION_CLASS) {
           auto clazz = declaration->cast<JSClassDeclarationNode>();
-          pushOperator(program, JS_OPERATOR::LOAD);
-          pushString(program, clazz->identifier->location.get(source));
+          pushLoad(program, clazz->identifier->location.get(source));
           pushOperator(program, JS_OPERATOR::EXPORT);
-          pushString(program, clazz->identifier->location.get(source));
+          pushIdentifier(program, clazz->identifier->location.get(source));
         } else if (declaration->type == JS_NODE_TYPE::DECLARATION_FUNCTION) {
           auto clazz = declaration->cast<JSFunctionDeclarationNode>();
-          pushOperator(program, JS_OPERATOR::LOAD);
-          pushString(program, clazz->identifier->location.get(source));
+          pushLoad(program, clazz->identifier->location.get(source));
           pushOperator(program, JS_OPERATOR::EXPORT);
-          pushString(program, clazz->identifier->location.get(source));
+          pushIdentifier(program, clazz->identifier->location.get(source));
         } else if (declaration->type == JS_NODE_TYPE::DECLARATION_VARIABLE) {
           for (auto &declarator :
                declaration->cast<JSVariableDeclaraionNode>()->declarations) {
@@ -856,17 +880,17 @@ JSNode *JSCodeGenerator::resolveArrowFunctionDeclaration(
   pushAddress(program, 0);
   for (auto &ref : func->closure) {
     pushOperator(program, JS_OPERATOR::REF);
-    pushString(program, ref);
+    pushIdentifier(program, ref);
   }
   pushOperator(program, JS_OPERATOR::JMP);
   auto end = program.codes.size();
   pushAddress(program, 0);
-  *(size_t *)(program.codes.data() + address) = program.codes.size();
-  auto err = resolveFunctionDeclaration(source, node, program);
+  setAddress(program, address, program.codes.size());
+  auto err = resolveLazyFunction(source, node, program);
   if (err) {
     return err;
   }
-  *(size_t *)(program.codes.data() + end) = program.codes.size();
+  setAddress(program, end, program.codes.size());
   return nullptr;
 }
 
@@ -875,11 +899,10 @@ JSNode *JSCodeGenerator::resolveFunctionDeclarator(const std::wstring &source,
                                                    JSProgram &program) {
   auto func = node->cast<JSFunctionDeclarationNode>();
   if (func->identifier) {
-    pushOperator(program, JS_OPERATOR::LOAD);
-    pushString(program, func->identifier->location.get(source));
+    pushLoad(program, func->identifier->location.get(source));
     for (auto &ref : func->closure) {
       pushOperator(program, JS_OPERATOR::REF);
-      pushString(program, ref);
+      pushIdentifier(program, ref);
     }
   } else {
     if (func->async) {
@@ -899,17 +922,17 @@ JSNode *JSCodeGenerator::resolveFunctionDeclarator(const std::wstring &source,
     pushAddress(program, 0);
     for (auto &ref : func->closure) {
       pushOperator(program, JS_OPERATOR::REF);
-      pushString(program, ref);
+      pushIdentifier(program, ref);
     }
     pushOperator(program, JS_OPERATOR::JMP);
     auto end = program.codes.size();
     pushAddress(program, 0);
-    *(size_t *)(program.codes.data() + address) = program.codes.size();
-    auto err = resolveFunctionDeclaration(source, node, program);
+    setAddress(program, address, program.codes.size());
+    auto err = resolveLazyFunction(source, node, program);
     if (err) {
       return err;
     }
-    *(size_t *)(program.codes.data() + end) = program.codes.size();
+    setAddress(program, end, program.codes.size());
   }
   return nullptr;
 }
@@ -917,7 +940,7 @@ JSNode *JSCodeGenerator::resolveFunctionDeclarator(const std::wstring &source,
 JSNode *JSCodeGenerator::resolveRegexLiteral(const std::wstring &source,
                                              JSNode *node, JSProgram &program) {
   pushOperator(program, JS_OPERATOR::REGEX);
-  pushString(program, node->location.get(source));
+  pushConstant(program, program.regexes, node->location.get(source));
   return nullptr;
 }
 
@@ -937,8 +960,7 @@ JSNode *JSCodeGenerator::resolveUndefinedLiteral(const std::wstring &source,
 JSNode *JSCodeGenerator::resolveIdentityLiteral(const std::wstring &source,
                                                 JSNode *node,
                                                 JSProgram &program) {
-  pushOperator(program, JS_OPERATOR::LOAD);
-  pushString(program, node->location.get(source));
+  pushLoad(program, node->location.get(source));
   return nullptr;
 }
 
@@ -948,7 +970,11 @@ JSNode *JSCodeGenerator::resolveBigintLiteral(const std::wstring &source,
   pushOperator(program, JS_OPERATOR::BIGINT);
   auto raw = node->location.get(source);
   raw = raw.substr(0, raw.length() - 1);
-  pushString(program, raw);
+  auto idx = program.bigintLiterals.resolve(raw);
+  if (idx == program.bigints.size()) {
+    program.bigints.emplace_back(raw);
+  }
+  pushUint32(program, idx);
   return nullptr;
 }
 
@@ -1024,8 +1050,8 @@ JSNode *JSCodeGenerator::resolveTemplateLiteral(const std::wstring &source,
       pushOperator(program, JS_OPERATOR::POP);
     }
     pushOperator(program, opt);
-    program.stacks[program.codes.size()] = {.position = temp->tag->location.end,
-                                            .filename = program.filename};
+    program.positions.push(program.codes.size(), temp->tag->location.end.line,
+                           temp->tag->location.end.column);
     pushUint32(program, temp->expressions.size() + 1);
   } else {
     auto str = temp->quasis[0]->location.get(source);
@@ -1037,12 +1063,14 @@ JSNode *JSCodeGenerator::resolveTemplateLiteral(const std::wstring &source,
       if (err) {
         return err;
       }
-      pushOperator(program, JS_OPERATOR::ADD);
       pushOperator(program, JS_OPERATOR::STR);
       pushString(program, temp->quasis[index + 1]->location.get(source));
-      pushOperator(program, JS_OPERATOR::ADD);
       index++;
     }
+    if (!temp->expressions.empty()) {
+      pushOperator(program, JS_OPERATOR::CONCAT);
+      pushUint32(program, temp->expressions.size() * 2 + 1);
+    }
   }
   return nullptr;
 }
@@ -1111,7 +1139,7 @@ JSNode *JSCodeGenerator::resolveWhileStatement(const std::wstring &source,
   pushOperator(program, JS_OPERATOR::JMP);
   pushAddress(program, start);
   auto end = program.codes.size();
-  *(size_t *)(program.codes.data() + end_address) = end;
+  setAddress(program, end_address, end);
   pushOperator(program, JS_OPERATOR::POP);
   popLabelFrame(program, start);
   popLabelFrame(program, end, label);
@@ -1180,7 +1208,7 @@ JSNode *JSCodeGenerator::resolveForStatement(const std::wstring &source,
   pushAddress(program, start);
   auto end = program.codes.size();
   if (end_address != 0) {
-    *(size_t *)(program.codes.data() + end_address) = end;
+    setAddress(program, end_address, end);
   }
   popLabelFrame(program, start);
   popLabelFrame(program, end, label);
@@ -1240,7 +1268,7 @@ JSNode *JSCodeGenerator::resolveForOfStatement(const std::wstring &source,
   }
   pushOperator(program, JS_OPERATOR::JMP);
   pushAddress(program, start);
-  *(size_t *)(program.codes.data() + end_address) = program.codes.size();
+  setAddress(program, end_address, program.codes.size());
   pushOperator(program, JS_OPERATOR::POP);
   pushOperator(program, JS_OPERATOR::POP);
   pushOperator(program, JS_OPERATOR::END);
@@ -1305,7 +1333,7 @@ JSNode *JSCodeGenerator::resolveForInStatement(const std::wstring &source,
   }
   pushOperator(program, JS_OPERATOR::JMP);
   pushAddress(program, start);
-  *(size_t *)(program.codes.data() + end_address) = program.codes.size();
+  setAddress(program, end_address, program.codes.size());
   pushOperator(program, JS_OPERATOR::POP);
   pushOperator(program, JS_OPERATOR::POP);
   pushOperator(program, JS_OPERATOR::END);
@@ -1369,7 +1397,7 @@ JSNode *JSCodeGenerator::resolveForAwaitOfStatement(const std::wstring &source,
   }
   pushOperator(program, JS_OPERATOR::JMP);
   pushAddress(program, start);
-  *(size_t *)(program.codes.data() + end_address) = program.codes.size();
+  setAddress(program, end_address, program.codes.size());
   pushOperator(program, JS_OPERATOR::POP);
   pushOperator(program, JS_OPERATOR::POP);
   pushOperator(program, JS_OPERATOR::END);
@@ -1394,8 +1422,7 @@ JSNode *JSCodeGenerator::resolveObjectDeclaration(const std::wstring &source,
           return err;
         }
       } else {
-        pushOperator(program, JS_OPERATOR::LOAD);
-        pushString(program, p->key->location.get(source));
+        pushLoad(program, p->key->location.get(source));
       }
       if (p->computed) {
         auto err = resolve(source, p->key, program);
@@ -1428,20 +1455,20 @@ JSNode *JSCodeGenerator::resolveObjectDeclaration(const std::wstring &source,
       auto address = program.codes.size();
       pushAddress(program, 0);
       pushOperator(program, JS_OPERATOR::SET_FUNCTION_NAME);
-      pushString(program, func->key->location.get(source));
+      pushIdentifier(program, func->key->location.get(source));
       for (auto &ref : func->closure) {
         pushOperator(program, JS_OPERATOR::REF);
-        pushString(program, ref);
+        pushIdentifier(program, ref);
       }
       pushOperator(program, JS_OPERATOR::JMP);
       auto end_address = program.codes.size();
       pushAddress(program, 0);
-      *(size_t *)(program.codes.data() + address) = program.codes.size();
+      setAddress(program, address, program.codes.size());
       auto err = resolveFunctionDeclaration(source, func, program);
       if (err) {
         return err;
       }
-      *(size_t *)(program.codes.data() + end_address) = program.codes.size();
+      setAddress(program, end_address, program.codes.size());
       if (func->computed) {
         auto err = resolve(source, func->key, program);
         if (err) {
@@ -1473,20 +1500,20 @@ JSNode *JSCodeGenerator::resolveObjectDeclaration(const std::wstring &source,
       auto address = program.codes.size();
       pushAddress(program, 0);
       pushOperator(program, JS_OPERATOR::SET_FUNCTION_NAME);
-      pushString(program, func->key->location.get(source));
+      pushIdentifier(program, func->key->location.get(source));
       for (auto &ref : func->closure) {
         pushOperator(program, JS_OPERATOR::REF);
-        pushString(program, ref);
+        pushIdentifier(program, ref);
       }
       pushOperator(program, JS_OPERATOR::JMP);
       auto end_address = program.codes.size();
       pushAddress(program, 0);
-      *(size_t *)(program.codes.data() + address) = program.codes.size();
+      setAddress(program, address, program.codes.size());
       auto err = resolveFunctionDeclaration(source, func, program);
       if (err) {
         return err;
       }
-      *(size_t *)(program.codes.data() + end_address) = program.codes.size();
+      setAddress(program, end_address, program.codes.size());
       if (func->computed) {
         auto err = resolve(source, func->key, program);
         if (err) {
@@ -1555,7 +1582,7 @@ JSNode *JSCodeGenerator::resolveClassDeclaration(const std::wstring &source,
   pushOperator(program, JS_OPERATOR::CLASS);
   if (declaration->identifier) {
     pushOperator(program, JS_OPERATOR::STORE);
-    pushString(program, declaration->identifier->location.get(source));
+    pushIdentifier(program, declaration->identifier->location.get(source));
   }
   auto lexCtx = _lexContext;
   _lexContext = node;
@@ -1582,20 +1609,20 @@ JSNode *JSCodeGenerator::resolveClassDeclaration(const std::wstring &source,
       auto address = program.codes.size();
       pushAddress(program, 0);
       pushOperator(program, JS_OPERATOR::SET_FUNCTION_NAME);
-      pushString(program, func->identifier->location.get(source));
+      pushIdentifier(program, func->identifier->location.get(source));
       for (auto &ref : func->closure) {
         pushOperator(program, JS_OPERATOR::REF);
-        pushString(program, ref);
+        pushIdentifier(program, ref);
       }
       pushOperator(program, JS_OPERATOR::JMP);
       auto end_address = program.codes.size();
       pushAddress(program, 0);
-      *(size_t *)(program.codes.data() + address) = program.codes.size();
+      setAddress(program, address, program.codes.size());
       auto err = resolveFunctionDeclaration(source, func, program);
       if (err) {
         return err;
       }
-      *(size_t *)(program.codes.data() + end_address) = program.codes.size();
+      setAddress(program, end_address, program.codes.size());
       if (func->computed) {
         auto err = resolve(source, func->identifier, program);
         if (err) {
@@ -1640,20 +1667,20 @@ JSNode *JSCodeGenerator::resolveClassDeclaration(const std::wstring &source,
       auto address = program.codes.size();
       pushAddress(program, 0);
       pushOperator(program, JS_OPERATOR::SET_FUNCTION_NAME);
-      pushString(program, func->identifier->location.get(source));
+      pushIdentifier(program, func->identifier->location.get(source));
       for (auto &ref : func->closure) {
         pushOperator(program, JS_OPERATOR::REF);
-        pushString(program, ref);
+        pushIdentifier(program, ref);
       }
       pushOperator(program, JS_OPERATOR::JMP);
       auto end_address = program.codes.size();
       pushAddress(program, 0);
-      *(size_t *)(program.codes.data() + address) = program.codes.size();
+      setAddress(program, address, program.codes.size());
       auto err = resolveFunctionDeclaration(source, func, program);
       if (err) {
         return err;
       }
-      *(size_t *)(program.codes.data() + end_address) = program.codes.size();
+      setAddress(program, end_address, program.codes.size());
       if (func->computed) {
         auto err = resolve(source, func->identifier, program);
         if (err) {
@@ -1747,7 +1774,7 @@ JSNode *JSCodeGenerator::resolveClassDeclaration(const std::wstring &source,
         pushOperator(program, JS_OPERATOR::JMP);
         auto end_address = program.codes.size();
         pushAddress(program, 0);
-        *(size_t *)(program.codes.data() + address) = program.codes.size();
+        setAddress(program, address, program.codes.size());
         if (p->value) {
           auto err = resolve(source, p->value, program);
           if (err) {
@@ -1757,7 +1784,7 @@ JSNode *JSCodeGenerator::resolveClassDeclaration(const std::wstring &source,
           pushOperator(program, JS_OPERATOR::UNDEFINED);
         }
         pushOperator(program, JS_OPERATOR::RET);
-        *(size_t *)(program.codes.data() + end_address) = program.codes.size();
+        setAddress(program, end_address, program.codes.size());
       }
     } else if (prop->type == JS_NODE_TYPE::CLASS_STATIC_BLOCK) {
       auto p = prop->cast<JSStaticBlockNode>();
@@ -1864,7 +1891,7 @@ JSNode *JSCodeGenerator::resolveBreakStatement(const std::wstring &source,
     label = statement->label->location.get(source);
   }
   pushOperator(program, JS_OPERATOR::BREAK);
-  pushString(program, label);
+  pushIdentifier(program, label);
   return nullptr;
 }
 
@@ -1877,7 +1904,7 @@ JSNode *JSCodeGenerator::resolveContinueStatement(const std::wstring &source,
     label = statement->label->location.get(source);
   }
   pushOperator(program, JS_OPERATOR::CONTINUE);
-  pushString(program, label);
+  pushIdentifier(program, label);
   return nullptr;
 }
 
@@ -1940,24 +1967,24 @@ JSNode *JSCodeGenerator::resolveTryStatement(const std::wstring &source,
     pushOperator(program, JS_OPERATOR::JMP);
     auto onerror_end = program.codes.size();
     pushAddress(program, 0);
-    *(size_t *)(program.codes.data() + onerror) = program.codes.size();
+    setAddress(program, onerror, program.codes.size());
     auto err = resolve(source, statement->onerror, program);
     if (err) {
       return err;
     }
-    *(size_t *)(program.codes.data() + onerror_end) = program.codes.size();
+    setAddress(program, onerror_end, program.codes.size());
   }
   if (statement->onfinish) {
     pushOperator(program, JS_OPERATOR::JMP);
     auto onfinish_end = program.codes.size();
     pushAddress(program, 0);
-    *(size_t *)(program.codes.data() + onfinish) = program.codes.size();
+    setAddress(program, onfinish, program.codes.size());
     auto err = resolve(source, statement->onfinish, program);
     if (err) {
       return err;
     }
     pushOperator(program, JS_OPERATOR::DEFER);
-    *(size_t *)(program.codes.data() + onfinish_end) = program.codes.size();
+    setAddress(program, onfinish_end, program.codes.size());
   }
   if (!label.empty()) {
     popLabelFrame(program, program.codes.size(), label);
@@ -1987,7 +2014,7 @@ JSNode *JSCodeGenerator::resolveIfStatement(const std::wstring &source,
   pushOperator(program, JS_OPERATOR::JMP);
   auto end = program.codes.size();
   pushAddress(program, 0);
-  *(uint64_t *)(program.codes.data() + alternate) = program.codes.size();
+  setAddress(program, alternate, program.codes.size());
   pushOperator(program, JS_OPERATOR::POP);
   if (statement->alternate) {
     err = resolve(source, statement->alternate, program);
@@ -1995,7 +2022,7 @@ JSNode *JSCodeGenerator::resolveIfStatement(const std::wstring &source,
       return err;
     }
   }
-  *(uint64_t *)(program.codes.data() + end) = program.codes.size();
+  setAddress(program, end, program.codes.size());
   if (!label.empty()) {
     popLabelFrame(program, program.codes.size(), label);
   }
@@ -2044,7 +2071,7 @@ JSNode *JSCodeGenerator::resolveSwitchStatement(const std::wstring &source,
     }
   }
   for (auto &[cas, addr] : addresses) {
-    *(uint64_t *)(program.codes.data() + addr) = program.codes.size();
+    setAddress(program, addr, program.codes.size());
     pushOperator(program, JS_OPERATOR::POP);
     for (auto statement : cas->statements) {
       auto err = resolve(source, statement, program);
@@ -2105,7 +2132,7 @@ JSNode *JSCodeGenerator::resolveBinaryExpression(const std::wstring &source,
     if (err) {
       return err;
     }
-    *(uint64_t *)(program.codes.data() + address) = program.codes.size();
+    setAddress(program, address, program.codes.size());
   } else if (opt == L"!") {
     auto err = resolve(source, expression->right, program);
     if (err) {
@@ -2213,7 +2240,7 @@ JSNode *JSCodeGenerator::resolveMemberExpression(const std::wstring &source,
     return err;
   }
   for (auto &addr : addresses) {
-    *(size_t *)(program.codes.data() + addr) = program.codes.size();
+    setAddress(program, addr, program.codes.size());
   }
   return nullptr;
 }
@@ -2227,7 +2254,7 @@ JSNode *JSCodeGenerator::resolveOptionalMemberExpression(
     return err;
   }
   for (auto &addr : addresses) {
-    *(size_t *)(program.codes.data() + addr) = program.codes.size();
+    setAddress(program, addr, program.codes.size());
   }
   return nullptr;
 }
@@ -2241,7 +2268,7 @@ JSNode *JSCodeGenerator::resolveComputedMemberExpression(
     return err;
   }
   for (auto &addr : addresses) {
-    *(size_t *)(program.codes.data() + addr) = program.codes.size();
+    setAddress(program, addr, program.codes.size());
   }
   return nullptr;
 }
@@ -2256,7 +2283,7 @@ JSNode *JSCodeGenerator::resolveOptionalComputedMemberExpression(
     return err;
   }
   for (auto &addr : addresses) {
-    *(size_t *)(program.codes.data() + addr) = program.codes.size();
+    setAddress(program, addr, program.codes.size());
   }
   return nullptr;
 }
@@ -2280,13 +2307,13 @@ JSNode *JSCodeGenerator::resolveConditionExpression(const std::wstring &source,
   pushOperator(program, JS_OPERATOR::JMP);
   auto end = program.codes.size();
   pushAddress(program, 0);
-  *(uint64_t *)(program.codes.data() + address) = program.codes.size();
+  setAddress(program, address, program.codes.size());
   pushOperator(program, JS_OPERATOR::POP);
   err = resolve(source, expression->alternate, program);
   if (err) {
     return err;
   }
-  *(uint64_t *)(program.codes.data() + end) = program.codes.size();
+  setAddress(program, end, program.codes.size());
   return nullptr;
 }
 
@@ -2300,7 +2327,7 @@ JSNode *JSCodeGenerator::resolveCallExpression(const std::wstring &source,
     return err;
   }
   for (auto &addr : addresses) {
-    *(size_t *)(program.codes.data() + addr) = program.codes.size();
+    setAddress(program, addr, program.codes.size());
   }
   return nullptr;
 }
@@ -2314,7 +2341,7 @@ JSNode *JSCodeGenerator::resolveOptionalCallExpression(
     return err;
   }
   for (auto &addr : addresses) {
-    *(size_t *)(program.codes.data() + addr) = program.codes.size();
+    setAddress(program, addr, program.codes.size());
   }
   return nullptr;
 }
@@ -2334,9 +2361,9 @@ JSNode *JSCodeGenerator::resolveNewExpression(const std::wstring &source,
     }
   }
   pushOperator(program, JS_OPERATOR::NEW);
-  program.stacks[program.codes.size()] = {.position =
-                                              expression->callee->location.end,
-                                          .filename = program.filename};
+  program.positions.push(program.codes.size(),
+                         expression->callee->location.end.line,
+                         expression->callee->location.end.column);
   pushUint32(program, (uint32_t)expression->arguments.size());
   return nullptr;
 }
@@ -2453,7 +2480,7 @@ JSNode *JSCodeGenerator::resolveAssigmentExpression(const std::wstring &source,
     if (err) {
       return err;
     }
-    *(uint64_t *)(program.codes.data() + address) = program.codes.size();
+    setAddress(program, address, program.codes.size());
   }
   if (opt == L"||=") {
     auto err = resolve(source, expression->left, program);
@@ -2468,7 +2495,7 @@ JSNode *JSCodeGenerator::resolveAssigmentExpression(const std::wstring &source,
     if (err) {
       return err;
     }
-    *(uint64_t *)(program.codes.data() + address) = program.codes.size();
+    setAddress(program, address, program.codes.size());
   }
   if (opt == LR"(??=)") {
     auto err = resolve(source, expression->left, program);
@@ -2483,7 +2510,7 @@ JSNode *JSCodeGenerator::resolveAssigmentExpression(const std::wstring &source,
     if (err) {
       return err;
     }
-    *(uint64_t *)(program.codes.data() + address) = program.codes.size();
+    setAddress(program, address, program.codes.size());
   }
   if (opt == L"=") {
     auto err = resolve(source, expression->right, program);
@@ -2557,7 +2584,7 @@ JSNode *JSCodeGenerator::resolveProgram(const std::wstring &source,
     auto str = directive->location.get(source);
     str = str.substr(1, str.size() - 2);
     pushOperator(program, JS_OPERATOR::ENABLE);
-    pushString(program, str);
+    pushIdentifier(program, str);
   }
   auto ctx = _lexContext;
   _lexContext = node;
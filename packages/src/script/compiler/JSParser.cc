@@ -171,38 +171,77 @@ void JSParser::resolveBinding(const std::wstring &source, JSNode *node) {
   }
 }
 
+JSNode *JSParser::parseFunction(const std::wstring &source, size_t offset,
+                                bool arrow,
+                                const std::vector<std::wstring> &closure,
+                                const JS_EVAL_TYPE &type) {
+  this->_type = type;
+  _refs.clear();
+  auto root = _allocator->create<JSProgramNode>();
+  root->scope = pushScope(JS_COMPILE_SCOPE_TYPE::LEX, root);
+  for (auto &name : closure) {
+    root->scope->declarations.push_back({JS_DECLARATION_TYPE::LET, root, name});
+  }
+  JSPosition current = {.offset = offset};
+  auto node = arrow ? readArrowFunctionDeclaration(source, current)
+                    : readFunctionDeclaration(source, current);
+  popScope();
+  if (!node) {
+    node = createError(L"Invalid or unexpected token", source, current);
+  }
+  if (node->type == JS_NODE_TYPE::ERROR) {
+    _allocator->dispose(root);
+    return node;
+  }
+  node->addParent(root);
+  resolveBinding(source, root);
+  node->removeParent(root);
+  node->scope->parent = nullptr;
+  _allocator->dispose(root);
+  return node;
+}
+
+JSNode *JSParser::parseChunk(const std::wstring &source,
+                             const std::set<std::wstring> &declared,
+                             size_t line, const JS_EVAL_TYPE &type) {
+  this->_type = type;
+  indexLines(source);
+  _tokenizer.reset(source);
+  _refs.clear();
+  _firstLine = line;
+  auto root = _allocator->create<JSProgramNode>();
+  root->scope = pushScope(JS_COMPILE_SCOPE_TYPE::LEX, root);
+  for (auto &name : declared) {
+    root->scope->declarations.push_back({JS_DECLARATION_TYPE::LET, root, name});
+  }
+  JSPosition pos = {};
+  auto node = readProgram(source, pos);
+  popScope();
+  _firstLine = 1;
+  if (node->type == JS_NODE_TYPE::ERROR) {
+    _allocator->dispose(root);
+    return node;
+  }
+  node->addParent(root);
+  resolveBinding(source, root);
+  node->removeParent(root);
+  node->scope->parent = nullptr;
+  _allocator->dispose(root);
+  return node;
+}
+
 JSNode *JSParser::readSymbolToken(const std::wstring &source,
                                   JSPosition &position) {
-  static const std::vector<std::wstring> operators = {
-      L">>>=",   L"...", L"<<=", L">>>", L"===", L"!==", L"**=", L">>=", L"&&=",
-      LR"(??=)", L"**",  L"==",  L"!=",  L"<<",  L">>",  L"<=",  L">=",  L"&&",
-      L"||",     L"??",  L"++",  L"--",  L"+=",  L"-=",  L"*=",  L"/=",  L"%=",
-      L"||=",    L"&=",  L"^=",  L"|=",  L"=>",  L"?.",  L"=",   L"*",   L"/",
-      L"%",      L"+",   L"-",   L"<",   L">",   L"&",   L"^",   L"|",   L",",
-      L"!",      L"~",   L"(",   L")",   L"[",   L"]",   L"{",   L"}",   L"@",
-      L"#",      L".",   L"?",   L":",   L";",
-  };
-  auto current = position;
-  for (auto &opt : operators) {
-    bool found = true;
-    auto offset = current.offset;
-    for (auto &ch : opt) {
-      auto &chr = source[offset];
-      if (chr != ch) {
-        found = false;
-        break;
-      }
-      offset++;
-    }
-    if (found) {
-      current.offset = offset;
-      auto token = _allocator->create<JSTokenNode>();
-      token->location = getLocation(source, position, current);
-      position = current;
-      return token;
-    }
+  auto length = _tokenizer.readSymbol(source, position.offset);
+  if (!length) {
+    return nullptr;
   }
-  return nullptr;
+  auto current = position;
+  current.offset += length;
+  auto token = _allocator->create<JSTokenNode>();
+  token->location = getLocation(source, position, current);
+  position = current;
+  return token;
 }
 
 JSNode *JSParser::readComments(const std::wstring &source, JSPosition &position,
@@ -320,50 +359,35 @@ JSNode *JSParser::readPrivateName(const std::wstring &source,
 
 JSNode *JSParser::readIdentifyLiteral(const std::wstring &source,
                                       JSPosition &position) {
-  auto current = position;
-  if (source[current.offset] == '$' || source[current.offset] == '_' ||
-      (source[current.offset] >= 'a' && source[current.offset] <= 'z') ||
-      (source[current.offset] >= 'A' && source[current.offset] <= 'Z')) {
-    current.offset++;
-    while ((source[current.offset] >= '0' && source[current.offset] <= '9') ||
-           (source[current.offset] >= 'A' && source[current.offset] <= 'Z') ||
-           (source[current.offset] >= 'a' && source[current.offset] <= 'z') ||
-           source[current.offset] == '$' || source[current.offset] == '_') {
-      current.offset++;
-    }
-    auto node = _allocator->create<JSIdentityLiteralNode>();
-    node->location = getLocation(source, position, current);
-    position = current;
-    return node;
+  auto length = _tokenizer.readIdentifier(source, position.offset);
+  if (!length) {
+    return nullptr;
   }
-  return nullptr;
+  auto current = position;
+  current.offset += length;
+  auto node = _allocator->create<JSIdentityLiteralNode>();
+  node->location = getLocation(source, position, current);
+  position = current;
+  return node;
 }
 
 JSNode *JSParser::readStringLiteral(const std::wstring &source,
                                     JSPosition &position) {
-
-  if (source[position.offset] == '\'' || source[position.offset] == '\"') {
-    auto current = position;
-    current.offset++;
-    for (;;) {
-      if (source[current.offset] == source[position.offset]) {
-        break;
-      }
-      if (!source[current.offset]) {
-        return createError(L"Invalid or unexpected token", source, current);
-      }
-      if (source[current.offset] == '\\') {
-        current.offset++;
-      }
-      current.offset++;
-    }
-    current.offset++;
-    auto token = _allocator->create<JSStringLiteralNode>();
-    token->location = getLocation(source, position, current);
-    position = current;
-    return token;
+  auto length = _tokenizer.readString(source, position.offset);
+  if (!length) {
+    return nullptr;
   }
-  return nullptr;
+  auto current = position;
+  if (length == JSTokenizer::UNTERMINATED) {
+    current.offset = std::min(source.find(L'\0', current.offset + 1),
+                              source.size());
+    return createError(L"Invalid or unexpected token", source, current);
+  }
+  current.offset += length;
+  auto token = _allocator->create<JSStringLiteralNode>();
+  token->location = getLocation(source, position, current);
+  position = current;
+  return token;
 }
 
 JSNode *JSParser::readNullLiteral(const std::wstring &source,
@@ -4826,12 +4850,7 @@ JSNode *JSParser::readPattern(const std::wstring &source,
   }
   if (!node) {
     auto current = position;
-    std::vector<JSLexDeclaration> backupDeclarations;
-    std::set<std::wstring> backupRefs;
-    if (_scope) {
-      backupDeclarations = _scope->declarations;
-      backupRefs = _scope->refs;
-    }
+    auto backup = checkpoint();
     node = readExpression17(source, current);
     if (node) {
       if (node->type != JS_NODE_TYPE::LITERAL_IDENTITY &&
@@ -4840,10 +4859,7 @@ JSNode *JSParser::readPattern(const std::wstring &source,
           node->type != JS_NODE_TYPE::EXPRESSION_MEMBER &&
           node->type != JS_NODE_TYPE::EXPRESSION_COMPUTED_MEMBER) {
         _allocator->dispose(node);
-        if (_scope) {
-          _scope->declarations = backupDeclarations;
-          _scope->refs = backupRefs;
-        }
+        rollback(backup);
         return nullptr;
       } else {
         position = current;
@@ -5741,8 +5757,7 @@ JSNode *JSParser::readExpression17(const std::wstring &source,
   }
   if (node) {
     if (node->type == JS_NODE_TYPE::LITERAL_IDENTITY) {
-      auto name = node->location.get(source);
-      _scope->refs.insert(name);
+      addRef(node->location.get(source));
     }
     auto current = position;
     bool optional = false;
@@ -6916,7 +6931,8 @@ JSNode *JSParser::readComment(const std::wstring &source, JSPosition &position,
   if (source[position.offset] == '/') {
     if (source[position.offset + 1] == '/') {
       auto current = position;
-      while (!isLineTerminator(source[current.offset])) {
+      while (source[current.offset] &&
+             !isLineTerminator(source[current.offset])) {
         current.offset++;
       }
       auto node = _allocator->create<JSCommentLiteralNode>();
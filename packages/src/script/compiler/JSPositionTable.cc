@@ -0,0 +1,98 @@
+#include "script/compiler/JSPositionTable.hpp"
+#include <algorithm>
+
+void JSPositionTable::writeVarint(uint64_t value) {
+  while (value >= 0x80) {
+    _data.push_back((uint8_t)(value | 0x80));
+    value >>= 7;
+  }
+  _data.push_back((uint8_t)value);
+}
+
+uint64_t JSPositionTable::readVarint(const uint8_t *&data) {
+  uint64_t value = 0;
+  uint32_t shift = 0;
+  while (*data & 0x80) {
+    value |= (uint64_t)(*data & 0x7f) << shift;
+    shift += 7;
+    data++;
+  }
+  value |= (uint64_t)*data << shift;
+  data++;
+  return value;
+}
+
+void JSPositionTable::push(size_t pc, size_t line, size_t column) {
+  if (_size % CHECKPOINT_INTERVAL == 0) {
+    _checkpoints.push_back({
+        .offset = _data.size(),
+        .pc = _pc,
+        .line = _line,
+        .first = pc,
+    });
+  }
+  auto delta = (int64_t)line - (int64_t)_line;
+  writeVarint(pc - _pc);
+  writeVarint(((uint64_t)delta << 1) ^ (uint64_t)(delta >> 63));
+  writeVarint(column);
+  _pc = pc;
+  _line = line;
+  _size++;
+}
+
+bool JSPositionTable::find(size_t pc, Entry &entry) const {
+  auto it = std::upper_bound(
+      _checkpoints.begin(), _checkpoints.end(), pc,
+      [](size_t value, const Checkpoint &checkpoint) {
+        return value < checkpoint.first;
+      });
+  if (it == _checkpoints.begin()) {
+    return false;
+  }
+  it--;
+  auto index = (size_t)(it - _checkpoints.begin()) * CHECKPOINT_INTERVAL;
+  auto end = std::min(index + CHECKPOINT_INTERVAL, _size);
+  const uint8_t *data = _data.data() + it->offset;
+  size_t current = it->pc;
+  size_t line = it->line;
+  for (; index < end; index++) {
+    current += readVarint(data);
+    auto delta = readVarint(data);
+    line += (size_t)((int64_t)(delta >> 1) ^ -(int64_t)(delta & 1));
+    auto column = readVarint(data);
+    if (current == pc) {
+      entry = {.pc = current, .line = line, .column = column};
+      return true;
+    }
+    if (current > pc) {
+      break;
+    }
+  }
+  return false;
+}
+
+std::vector<JSPositionTable::Entry> JSPositionTable::getEntries() const {
+  std::vector<Entry> entries;
+  entries.reserve(_size);
+  const uint8_t *data = _data.data();
+  size_t pc = 0;
+  size_t line = 0;
+  for (size_t index = 0; index < _size; index++) {
+    pc += readVarint(data);
+    auto delta = readVarint(data);
+    line += (size_t)((int64_t)(delta >> 1) ^ -(int64_t)(delta & 1));
+    entries.push_back({.pc = pc, .line = line, .column = readVarint(data)});
+  }
+  return entries;
+}
+
+void JSPositionTable::truncate(size_t pc) {
+  auto entries = getEntries();
+  *this = {};
+  for (auto &entry : entries) {
+    if (entry.pc >= pc) {
+      break;
+    }
+    push(entry.pc, entry.line, entry.column);
+  }
+}
@@ -0,0 +1,202 @@
+#include "script/compiler/JSTokenizer.hpp"
+#include <cwchar>
+
+void JSTokenizer::reset(const std::wstring &source) {
+  for (auto &tokens : _tokens) {
+    tokens.clear();
+  }
+  _source = source.data();
+  _size = source.size();
+}
+
+size_t JSTokenizer::read(const KIND &kind, const std::wstring &source,
+                         size_t offset) {
+  if (_source != source.data() || _size != source.size()) {
+    reset(source);
+  }
+  auto &tokens = _tokens[(size_t)kind];
+  if (tokens.empty()) {
+    tokens.resize(_size + 1, 0);
+  }
+  if (offset > _size) {
+    return 0;
+  }
+  auto &token = tokens[offset];
+  if (!token) {
+    size_t length = 0;
+    switch (kind) {
+    case KIND::SYMBOL:
+      length = scanSymbol(source, offset);
+      break;
+    case KIND::IDENTIFIER:
+      length = scanIdentifier(source, offset);
+      break;
+    case KIND::STRING:
+      length = scanString(source, offset);
+      break;
+    default:
+      break;
+    }
+    token = length == UNTERMINATED ? UINT32_MAX : (uint32_t)length + 1;
+  }
+  if (token == UINT32_MAX) {
+    return UNTERMINATED;
+  }
+  return token - 1;
+}
+
+// every keyword is at least two characters long, so the hash can read the
+// second character; KEYWORD_TABLE construction fails to compile if two
+// keywords ever share a slot
+static constexpr size_t KEYWORD_TABLE_SIZE = 128;
+
+static constexpr size_t KEYWORD_MAX_LENGTH = 10;
+
+static constexpr size_t hashKeyword(const wchar_t *name, size_t length) {
+  return ((size_t)name[0] + (size_t)name[1] * 13 + length * 11) &
+         (KEYWORD_TABLE_SIZE - 1);
+}
+
+static constexpr std::array<const wchar_t *, KEYWORD_TABLE_SIZE>
+    KEYWORD_TABLE = [] {
+      constexpr const wchar_t *keywords[] = {
+          L"break",      L"case",     L"catch",   L"class",  L"const",
+          L"continue",   L"debugger", L"default", L"delete", L"do",
+          L"else",       L"export",   L"extends", L"false",  L"finally",
+          L"for",        L"function", L"if",      L"import", L"in",
+          L"instanceof", L"new",      L"null",    L"return", L"super",
+          L"switch",     L"this",     L"throw",   L"true",   L"try",
+          L"typeof",     L"var",      L"void",    L"while",  L"with",
+          L"let",        L"static"};
+      std::array<const wchar_t *, KEYWORD_TABLE_SIZE> table{};
+      for (auto keyword : keywords) {
+        auto length = std::char_traits<wchar_t>::length(keyword);
+        if (length < 2 || length > KEYWORD_MAX_LENGTH) {
+          throw "keyword length out of range";
+        }
+        auto &slot = table[hashKeyword(keyword, length)];
+        if (slot) {
+          throw "keyword hash collision";
+        }
+        slot = keyword;
+      }
+      return table;
+    }();
+
+bool JSTokenizer::isKeyword(const wchar_t *name, size_t length) {
+  if (length < 2 || length > KEYWORD_MAX_LENGTH) {
+    return false;
+  }
+  auto keyword = KEYWORD_TABLE[hashKeyword(name, length)];
+  return keyword && std::char_traits<wchar_t>::length(keyword) == length &&
+         std::char_traits<wchar_t>::compare(keyword, name, length) == 0;
+}
+
+// longest match first; reads past the first character only after it
+// matched, so the source terminator stops every path
+size_t JSTokenizer::scanSymbol(const std::wstring &source,
+                               size_t offset) const {
+  auto s = source.c_str() + offset;
+  switch (s[0]) {
+  case '>':
+    if (s[1] == '>') {
+      if (s[2] == '>') {
+        return s[3] == '=' ? 4 : 3;
+      }
+      return s[2] == '=' ? 3 : 2;
+    }
+    return s[1] == '=' ? 2 : 1;
+  case '<':
+    if (s[1] == '<') {
+      return s[2] == '=' ? 3 : 2;
+    }
+    return s[1] == '=' ? 2 : 1;
+  case '=':
+    if (s[1] == '=') {
+      return s[2] == '=' ? 3 : 2;
+    }
+    return s[1] == '>' ? 2 : 1;
+  case '!':
+    if (s[1] == '=') {
+      return s[2] == '=' ? 3 : 2;
+    }
+    return 1;
+  case '*':
+  case '&':
+  case '|':
+    if (s[1] == s[0]) {
+      return s[2] == '=' ? 3 : 2;
+    }
+    return s[1] == '=' ? 2 : 1;
+  case '?':
+    if (s[1] == '?') {
+      return s[2] == '=' ? 3 : 2;
+    }
+    return s[1] == '.' ? 2 : 1;
+  case '+':
+  case '-':
+    if (s[1] == s[0]) {
+      return 2;
+    }
+    return s[1] == '=' ? 2 : 1;
+  case '/':
+  case '%':
+  case '^':
+    return s[1] == '=' ? 2 : 1;
+  case '.':
+    return s[1] == '.' && s[2] == '.' ? 3 : 1;
+  case ',':
+  case '~':
+  case '(':
+  case ')':
+  case '[':
+  case ']':
+  case '{':
+  case '}':
+  case '@':
+  case '#':
+  case ':':
+  case ';':
+    return 1;
+  default:
+    return 0;
+  }
+}
+
+size_t JSTokenizer::scanIdentifier(const std::wstring &source,
+                                   size_t offset) const {
+  auto s = source.c_str() + offset;
+  if (!isIdentifierStart(s[0])) {
+    return 0;
+  }
+  size_t length = 1;
+  while (isIdentifierPart(s[length])) {
+    length++;
+  }
+  return length;
+}
+
+size_t JSTokenizer::scanString(const std::wstring &source,
+                               size_t offset) const {
+  auto quote = source[offset];
+  if (quote != '\'' && quote != '\"') {
+    return 0;
+  }
+  const wchar_t stops[] = {quote, '\\', 0};
+  auto s = source.c_str();
+  auto current = offset + 1;
+  for (;;) {
+    current += std::wcscspn(s + current, stops);
+    if (s[current] == quote) {
+      break;
+    }
+    if (!s[current]) {
+      return UNTERMINATED;
+    }
+    if (s[current + 1]) {
+      current++;
+    }
+    current++;
+  }
+  return current + 1 - offset;
+}
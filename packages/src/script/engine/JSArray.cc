@@ -3,4 +3,6 @@
 #include "script/util/JSSingleton.hpp"
 
 JSArray::JSArray(JSAllocator *allocator)
-    : JSObject(allocator, JSSingleton::instance<JSArrayType>(allocator)) {}
+    : JSObject(allocator, JSSingleton::instance<JSArrayType>(allocator)) {
+  _mask = MASK;
+}
@@ -4,13 +4,16 @@
 #include "script/engine/JSException.hpp"
 #include "script/engine/JSInfinityType.hpp"
 #include "script/engine/JSNaNType.hpp"
+#include "script/engine/JSNumber.hpp"
 #include "script/engine/JSNumberType.hpp"
 #include "script/engine/JSObjectType.hpp"
 #include "script/engine/JSValue.hpp"
 #include "script/util/JSAllocator.hpp"
 #include <sstream>
 
-JSArrayType ::JSArrayType(JSAllocator *allocator) : JSObjectType(allocator) {}
+JSArrayType ::JSArrayType(JSAllocator *allocator) : JSObjectType(allocator) {
+  _mask = MASK;
+}
 
 JSValue *JSArrayType::toString(JSContext *ctx, JSValue *value) const {
   std::wstringstream ss;
@@ -31,77 +34,87 @@ JSValue *JSArrayType::toString(JSContext *ctx, JSValue *value) const {
   return ctx->createString(ss.str());
 }
 
-JSValue *JSArrayType::getField(JSContext *ctx, JSValue *array,
-                               JSValue *name) const {
+bool JSArrayType::getIndex(JSContext *ctx, JSValue *name,
+                           size_t &index) const {
+  auto number = name->getData()->cast<JSNumber>();
+  if (number && number->isInteger()) {
+    if (number->getInteger() < 0) {
+      return false;
+    }
+    index = number->getInteger();
+    return true;
+  }
   auto numval = ctx->toNumber(name);
   if (numval->isTypeof<JSNumberType>() && !numval->isTypeof<JSNaNType>() &&
       !numval->isTypeof<JSInfinityType>()) {
     auto num = ctx->checkedNumber(numval);
-    size_t idx = (size_t)num;
-    if (idx == num) {
-      auto arr = array->getData()->cast<JSArray>();
-      auto &items = arr->getItems();
-      if (items.contains(idx)) {
-        return ctx->createValue(arr->getItems().at(idx));
-      }
-      return ctx->createUndefined();
+    index = (size_t)num;
+    return index == num;
+  }
+  return false;
+}
+
+JSValue *JSArrayType::getField(JSContext *ctx, JSValue *array,
+                               JSValue *name, JSValue *self) const {
+  size_t idx;
+  if (getIndex(ctx, name, idx)) {
+    auto arr = array->getData()->cast<JSArray>();
+    auto &items = arr->getItems();
+    auto it = items.find(idx);
+    if (it != items.end()) {
+      return ctx->createValue(it->second);
     }
+    return ctx->createUndefined();
   }
   if (ctx->checkedString(name) == L"length") {
     return ctx->createNumber(array->getData()->cast<JSArray>()->getLength());
   }
-  return JSObjectType::getField(ctx, array, name);
+  return JSObjectType::getField(ctx, array, name, self);
 };
 
 JSValue *JSArrayType::setField(JSContext *ctx, JSValue *array, JSValue *name,
                                JSValue *value) const {
-  auto numval = ctx->toNumber(name);
-  if (numval->isTypeof<JSNumberType>() && !numval->isTypeof<JSNaNType>() &&
-      !numval->isTypeof<JSInfinityType>()) {
-    auto num = ctx->checkedNumber(numval);
-    size_t idx = (size_t)num;
-    if (idx == num) {
-      auto arr = array->getData()->cast<JSArray>();
-      auto &items = arr->getItems();
-      if (items.contains(idx)) {
-        auto oldval = ctx->createValue(items.at(idx));
-        if (oldval->getType() != value->getType() ||
-            !ctx->isEqual(oldval, value)) {
-          if (arr->isFrozen()) {
-            return ctx->createException(
-                JSException::TYPE::TYPE,
-                std::format(
-                    L"Cannot assign to read only property '{}' of object "
-                    L"'#<Object>'",
-                    idx));
-          }
-          array->getAtom()->removeChild(oldval->getAtom());
-          ctx->recycle(oldval->getAtom());
-          array->getAtom()->addChild(value->getAtom());
-          items[idx] = value->getAtom();
-        }
-      } else {
-        if (arr->isFrozen() || !arr->isExtensible() || arr->isSealed()) {
+  size_t idx;
+  if (getIndex(ctx, name, idx)) {
+    auto arr = array->getData()->cast<JSArray>();
+    auto &items = arr->getItems();
+    if (items.contains(idx)) {
+      auto oldval = ctx->createValue(items.at(idx));
+      if (oldval->getType() != value->getType() ||
+          !ctx->isEqual(oldval, value)) {
+        if (arr->isFrozen()) {
           return ctx->createException(
               JSException::TYPE::TYPE,
-              std::format(L"Cannot add property {}, object is not extensible",
-                          idx));
+              std::format(
+                  L"Cannot assign to read only property '{}' of object "
+                  L"'#<Object>'",
+                  idx));
         }
+        array->getAtom()->removeChild(oldval->getAtom());
+        ctx->recycle(oldval->getAtom());
         array->getAtom()->addChild(value->getAtom());
         items[idx] = value->getAtom();
-        if (idx >= arr->getLength()) {
-          arr->setLength(idx + 1);
-          auto err = ctx->defineProperty(array, ctx->createString(L"array"),
-                                         ctx->createNumber(arr->getLength()),
-                                         true, false, true);
-          CHECK(ctx, err);
-        }
       }
-      return ctx->createUndefined();
+    } else {
+      if (arr->isFrozen() || !arr->isExtensible() || arr->isSealed()) {
+        return ctx->createException(
+            JSException::TYPE::TYPE,
+            std::format(L"Cannot add property {}, object is not extensible",
+                        idx));
+      }
+      array->getAtom()->addChild(value->getAtom());
+      items[idx] = value->getAtom();
+      if (idx >= arr->getLength()) {
+        arr->setLength(idx + 1);
+        auto err = ctx->defineProperty(array, ctx->createString(L"array"),
+                                       ctx->createNumber(arr->getLength()),
+                                       true, false, true);
+        CHECK(ctx, err);
+      }
     }
+    return ctx->createUndefined();
   }
   if (ctx->checkedString(name) == L"length") {
-
     auto arr = array->getData()->cast<JSArray>();
     auto &items = arr->getItems();
     value = ctx->toNumber(value);
@@ -7,4 +7,6 @@
 
 JSBigInt::JSBigInt(JSAllocator *allocator, const BigInt<> &value)
     : JSBase(allocator, JSSingleton::instance<JSBigIntType>(allocator)),
-      _value(value) {}
\ No newline at end of file
+      _value(value) {
+  _mask = MASK;
+}
\ No newline at end of file
@@ -7,7 +7,9 @@
 #include "script/util/JSAllocator.hpp"
 #include <cmath>
 
-JSBigIntType::JSBigIntType(JSAllocator *allocator) : JSType(allocator) {}
+JSBigIntType::JSBigIntType(JSAllocator *allocator) : JSType(allocator) {
+  _mask = MASK;
+}
 
 const wchar_t *JSBigIntType::getTypeName() const { return L"bigint"; }
 
@@ -71,12 +73,18 @@ JSValue *JSBigIntType::mul(JSContext *ctx, JSValue *value,
 
 JSValue *JSBigIntType::div(JSContext *ctx, JSValue *value,
                            JSValue *another) const {
+  if (another->getData()->cast<JSBigInt>()->getValue() == 0) {
+    return ctx->createException(JSException::TYPE::RANGE, L"Division by zero");
+  }
   return ctx->createBigInt(value->getData()->cast<JSBigInt>()->getValue() /
                            another->getData()->cast<JSBigInt>()->getValue());
 }
 
 JSValue *JSBigIntType::mod(JSContext *ctx, JSValue *value,
                            JSValue *another) const {
+  if (another->getData()->cast<JSBigInt>()->getValue() == 0) {
+    return ctx->createException(JSException::TYPE::RANGE, L"Division by zero");
+  }
   return ctx->createBigInt(value->getData()->cast<JSBigInt>()->getValue() %
                            another->getData()->cast<JSBigInt>()->getValue());
 }
@@ -87,8 +95,29 @@ JSValue *JSBigIntType::unaryNegation(JSContext *ctx, JSValue *value) const {
 
 JSValue *JSBigIntType::pow(JSContext *ctx, JSValue *value,
                            JSValue *another) const {
-  return ctx->createBigInt(value->getData()->cast<JSBigInt>()->getValue().pow(
-      another->getData()->cast<JSBigInt>()->getValue()));
+  auto &base = value->getData()->cast<JSBigInt>()->getValue();
+  auto &exponent = another->getData()->cast<JSBigInt>()->getValue();
+  if (exponent < 0) {
+    return ctx->createException(JSException::TYPE::RANGE,
+                                L"Exponent must be non-negative");
+  }
+  if (base == 0) {
+    return ctx->createBigInt(exponent == 0 ? BigInt<>(1) : BigInt<>());
+  }
+  if (base == 1) {
+    return ctx->createBigInt(base);
+  }
+  if (base == -1) {
+    return ctx->createBigInt((exponent & BigInt<>(1)) == 0 ? BigInt<>(1)
+                                                          : base);
+  }
+  auto bits = exponent.toInt64();
+  if (!bits || (uint64_t)*bits > MAX_BIT_LENGTH ||
+      (base.getBitLength() - 1) * (uint64_t)*bits > MAX_BIT_LENGTH) {
+    return ctx->createException(JSException::TYPE::RANGE,
+                                L"Maximum BigInt size exceeded");
+  }
+  return ctx->createBigInt(base.pow(exponent));
 }
 
 JSValue *JSBigIntType::and_(JSContext *ctx, JSValue *value,
@@ -135,16 +164,41 @@ JSValue *JSBigIntType::xor_(JSContext *ctx, JSValue *value,
                            another->getData()->cast<JSBigInt>()->getValue());
 }
 
+// counts too large for a shift to take are decided here, so BigInt never
+// sees them
+static JSValue *shift(JSContext *ctx, const BigInt<> &value,
+                      const BigInt<> &count, bool left) {
+  if (count.isNetative()) {
+    left = !left;
+  }
+  auto bits = count.abs().toInt64();
+  if (!left) {
+    if (!bits || (uint64_t)*bits >= value.getBitLength()) {
+      return ctx->createBigInt(value.isNetative() ? BigInt<>(-1) : BigInt<>());
+    }
+    return ctx->createBigInt(value >> BigInt<>(*bits));
+  }
+  if (value == 0) {
+    return ctx->createBigInt(value);
+  }
+  if (!bits || (uint64_t)*bits > JSBigIntType::MAX_BIT_LENGTH ||
+      value.getBitLength() + *bits > JSBigIntType::MAX_BIT_LENGTH) {
+    return ctx->createException(JSException::TYPE::RANGE,
+                                L"Maximum BigInt size exceeded");
+  }
+  return ctx->createBigInt(value << BigInt<>(*bits));
+}
+
 JSValue *JSBigIntType::shr(JSContext *ctx, JSValue *value,
                            JSValue *another) const {
-  return ctx->createBigInt(value->getData()->cast<JSBigInt>()->getValue() >>
-                           another->getData()->cast<JSBigInt>()->getValue());
+  return shift(ctx, value->getData()->cast<JSBigInt>()->getValue(),
+               another->getData()->cast<JSBigInt>()->getValue(), false);
 }
 
 JSValue *JSBigIntType::shl(JSContext *ctx, JSValue *value,
                            JSValue *another) const {
-  return ctx->createBigInt(value->getData()->cast<JSBigInt>()->getValue()
-                           << another->getData()->cast<JSBigInt>()->getValue());
+  return shift(ctx, value->getData()->cast<JSBigInt>()->getValue(),
+               another->getData()->cast<JSBigInt>()->getValue(), true);
 }
 
 JSValue *JSBigIntType::gt(JSContext *ctx, JSValue *value,
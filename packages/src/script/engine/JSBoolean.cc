@@ -5,4 +5,6 @@
 
 JSBoolean::JSBoolean(JSAllocator *allocator, bool value)
     : JSBase(allocator, JSSingleton::instance<JSBooleanType>(allocator)),
-      _value(value) {}
+      _value(value) {
+  _mask = MASK;
+}
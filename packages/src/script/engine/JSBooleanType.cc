@@ -4,7 +4,9 @@
 #include "script/engine/JSType.hpp"
 #include "script/engine/JSValue.hpp"
 #include "script/util/JSAllocator.hpp"
-JSBooleanType::JSBooleanType(JSAllocator *allocator) : JSType(allocator) {}
+JSBooleanType::JSBooleanType(JSAllocator *allocator) : JSType(allocator) {
+  _mask = MASK;
+}
 
 const wchar_t *JSBooleanType::getTypeName() const { return L"boolean"; }
 
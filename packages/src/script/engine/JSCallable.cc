@@ -3,7 +3,10 @@ JSCallable::JSCallable(
     JSAllocator *allocator, const std::wstring &name,
     const std::unordered_map<std::wstring, JSAtom *> &closure, JSType *type)
     : JSObject(allocator, type), _closure(closure), _name(name),
-      _globalContext(false), _self(nullptr), _clazz(nullptr){};
+      _globalContext(false), _lazy(false), _self(nullptr),
+      _clazz(nullptr) {
+  _mask = MASK;
+};
 
 void JSCallable::setSelf(JSAtom *self) { _self = self; }
 
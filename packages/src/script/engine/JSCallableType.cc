@@ -1,11 +1,74 @@
 #include "script/engine/JSCallableType.hpp"
+#include "script/engine/JSAtom.hpp"
 #include "script/engine/JSCallable.hpp"
 #include "script/engine/JSObjectType.hpp"
 #include "script/util/JSAllocator.hpp"
+#include <set>
 JSCallableType::JSCallableType(JSAllocator *allocator)
-    : JSObjectType(allocator) {}
+    : JSObjectType(allocator) {
+  _mask = MASK;
+}
 const wchar_t *JSCallableType::getTypeName() const { return L"function"; }
 
+JSValue *JSCallableType::materialize(JSContext *ctx, JSAtom *atom) const {
+  auto fn = atom->getData()->cast<JSCallable>();
+  if (!fn->isLazy()) {
+    return nullptr;
+  }
+  // defineProperty looks the fields up again, so the flag is dropped while
+  // they are built and restored together with them if one fails
+  fn->setLazy(false);
+  auto &fields = fn->getFields();
+  std::set<JSAtom *> keys;
+  for (auto &[key, _] : fields) {
+    keys.insert(key);
+  }
+  auto current = ctx->getScope();
+  ctx->pushScope();
+  auto build = [&]() -> JSValue * {
+    auto value = ctx->createValue(atom);
+    auto prototype = ctx->createObject();
+    CHECK(ctx, prototype);
+    auto err = defineProperty(ctx, value, ctx->createString(L"prototype"),
+                              prototype, true, false, true);
+    CHECK(ctx, err);
+    err = ctx->defineProperty(prototype, ctx->createString(L"constructor"),
+                              value, true, false, true);
+    CHECK(ctx, err);
+    err = defineProperty(ctx, value, ctx->createString(L"name"),
+                         ctx->createString(fn->getName()), false, false, false);
+    CHECK(ctx, err);
+    auto constructor = fn->getConstructor();
+    if (constructor) {
+      err = defineProperty(ctx, value, ctx->createString(L"constructor"),
+                           ctx->createValue(constructor), true, false, true);
+      CHECK(ctx, err);
+    }
+    return nullptr;
+  };
+  auto err = build();
+  if (err) {
+    err = current->createValue(err->getAtom());
+    for (auto it = fields.begin(); it != fields.end();) {
+      if (keys.contains(it->first)) {
+        ++it;
+        continue;
+      }
+      atom->removeChild(it->first);
+      if (it->second.value) {
+        atom->removeChild(it->second.value);
+      }
+      it = fields.erase(it);
+    }
+    fn->setLazy(true);
+  }
+  // defineProperty leaves its own scope open when it throws
+  while (ctx->getScope() != current) {
+    ctx->popScope();
+  }
+  return err;
+}
+
 JSValue *JSCallableType::setSelf(JSContext *ctx, JSValue *value,
                                  JSValue *self) const {
   auto fn = value->getData()->cast<JSCallable>();
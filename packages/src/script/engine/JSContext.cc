@@ -40,18 +40,14 @@
 #include "script/runtime/JSObjectConstructor.hpp"
 #include "script/runtime/JSStringConstructor.hpp"
 #include "script/runtime/JSSymbolConstructor.hpp"
+#include "script/util/JSSingleton.hpp"
 #include <fstream>
 #include <iostream>
 
 JSContext::JSContext(JSRuntime *runtime) : _runtime(runtime), _global(nullptr) {
   _root = getAllocator()->create<JSScope>();
   _current = _root;
-  _callstacks.push_back({
-      .position =
-          {
-              .funcname = L"neo.run",
-          },
-  });
+  _callstacks.push_back({});
   auto err = initializeGlobal();
   if (err) {
     _global = err;
@@ -97,49 +93,129 @@ JSValue *JSContext::eval(const std::wstring &filename,
   return _runtime->getVirtualMachine()->eval(this, program);
 }
 
+JSValue *JSContext::evalStream(const std::wstring &filename,
+                               std::wistream &input,
+                               const JS_EVAL_TYPE &type) {
+  CHECK(this, _global);
+  JSStreamState stream = {.type = type};
+  JSValue *result = createUndefined();
+  size_t pc = 0;
+  size_t size = STREAM_CHUNK_SIZE;
+  for (;;) {
+    auto offset = stream.buffer.size();
+    stream.buffer.resize(offset + size);
+    input.read(stream.buffer.data() + offset, size);
+    stream.buffer.resize(offset + input.gcount());
+    std::wstring line;
+    if (std::getline(input, line)) {
+      stream.buffer += line;
+      stream.buffer += L'\n';
+    }
+    auto final = !input.good();
+    auto err = _runtime->compileChunk(filename, stream, final);
+    if (err) {
+      auto error = err->cast<JSErrorNode>();
+      auto exception = createException(
+          JSException::TYPE::SYNTAX, error->message, filename,
+          error->location.end.column, error->location.end.line);
+      getAllocator()->dispose(err);
+      return exception;
+    }
+    auto &program = _runtime->getProgram(filename);
+    if (program.codes.size() != pc) {
+      JSEvalContext ectx = {.pc = pc};
+      pc = program.codes.size();
+      result = _runtime->getVirtualMachine()->eval(this, program, ectx);
+      if (isException(result)) {
+        return result;
+      }
+      size = STREAM_CHUNK_SIZE;
+    } else if (stream.buffer.size() > size) {
+      size = stream.buffer.size();
+    }
+    if (final) {
+      break;
+    }
+  }
+  return result;
+}
+
 JSValue *JSContext::initializeGlobal() {
   _global = createObject(createNull());
   auto err = setField(_global, createString(L"global"), _global);
   CHECK(this, err)
   _Function = JSFunctionConstructor::initialize(this);
   CHECK(this, _Function)
+  _FunctionPrototype = getField(_Function, createString(L"prototype"));
+  CHECK(this, _FunctionPrototype);
   _Object = JSObjectConstructor::initialize(this);
   CHECK(this, _Object)
+  _ObjectPrototype = getField(_Object, createString(L"prototype"));
+  CHECK(this, _ObjectPrototype);
   _Symbol = JSSymbolConstructor::initialize(this);
   CHECK(this, _Symbol)
+  _SymbolPrototype = getField(_Symbol, createString(L"prototype"));
+  CHECK(this, _SymbolPrototype);
   _Array = JSArrayConstructor::initialize(this);
   CHECK(this, _Array);
+  _ArrayPrototype = getField(_Array, createString(L"prototype"));
+  CHECK(this, _ArrayPrototype);
   _Boolean = JSBooleanConstructor::initialize(this);
   CHECK(this, _Boolean)
+  _BooleanPrototype = getField(_Boolean, createString(L"prototype"));
+  CHECK(this, _BooleanPrototype);
   _Number = JSNumberConstructor::initialize(this);
   CHECK(this, _Number)
+  _NumberPrototype = getField(_Number, createString(L"prototype"));
+  CHECK(this, _NumberPrototype);
   _String = JSStringConstructor::initialize(this);
   CHECK(this, _String)
+  _StringPrototype = getField(_String, createString(L"prototype"));
+  CHECK(this, _StringPrototype);
   _BigInt = JSBigIntConstructor::initialize(this);
   CHECK(this, _BigInt)
+  _BigIntPrototype = getField(_BigInt, createString(L"prototype"));
+  CHECK(this, _BigIntPrototype);
   _GeneratorFunction = JSGeneratorFunctionConstructor::initialize(this);
   CHECK(this, _GeneratorFunction);
+  _GeneratorFunctionPrototype =
+      getField(_GeneratorFunction, createString(L"prototype"));
+  CHECK(this, _GeneratorFunctionPrototype);
   _Generator = JSGeneratorConstructor::initialize(this);
   CHECK(this, _Generator);
+  _GeneratorPrototype = getField(_Generator, createString(L"prototype"));
+  CHECK(this, _GeneratorPrototype);
   return nullptr;
 }
 
-void JSContext::pushCallStack(const std::wstring &filename,
-                              const std::wstring &funcname, size_t column,
-                              size_t line) {
-  _callstacks.rbegin()->position.column = column;
-  _callstacks.rbegin()->position.line = line;
-  _callstacks.rbegin()->filename = filename;
-  _callstacks.push_back({
-      .position = {.funcname = funcname},
-  });
+void JSContext::pushCallStack(const JSCallable *callee,
+                              const JSProgram *program, size_t pc) {
+  _callstacks.rbegin()->program = program;
+  _callstacks.rbegin()->pc = pc;
+  _callstacks.push_back({.callee = callee});
 }
 
 void JSContext::popCallStack() { _callstacks.pop_back(); }
 
 std::vector<JSStackFrame> JSContext::trace(const std::wstring &filename,
                                            size_t column, size_t line) {
-  auto result = _callstacks;
+  std::vector<JSStackFrame> result;
+  result.reserve(_callstacks.size());
+  for (auto &frame : _callstacks) {
+    JSStackFrame item = {};
+    if (!frame.callee) {
+      item.position.funcname = L"neo.run";
+    } else {
+      item.position.funcname = frame.callee->getName();
+    }
+    JSPositionTable::Entry site;
+    if (frame.program && frame.program->positions.find(frame.pc, site)) {
+      item.filename = frame.program->filename;
+      item.position.line = site.line;
+      item.position.column = site.column;
+    }
+    result.push_back(item);
+  }
   result.rbegin()->filename = filename;
   result.rbegin()->position.column = column;
   result.rbegin()->position.line = line;
@@ -229,11 +305,21 @@ JSValue *JSContext::createNumber(double value) {
       _runtime->getAllocator()->create<JSNumber>(value));
 }
 
+JSValue *JSContext::createInteger(int32_t value) {
+  return _current->createValue(
+      _runtime->getAllocator()->create<JSNumber>(value));
+}
+
 JSValue *JSContext::createString(const std::wstring &value) {
   return _current->createValue(
       _runtime->getAllocator()->create<JSString>(value));
 }
 
+JSValue *JSContext::createString(const std::shared_ptr<JSString::Rope> &rope) {
+  return _current->createValue(
+      _runtime->getAllocator()->create<JSString>(rope));
+}
+
 JSValue *JSContext::createBoolean(bool value) {
   return _current->createValue(
       _runtime->getAllocator()->create<JSBoolean>(value));
@@ -243,9 +329,9 @@ JSValue *JSContext::createObject(JSValue *prototype) {
 
   auto object = _current->createValue(getAllocator()->create<JSObject>());
   auto obj = object->getData()->cast<JSObject>();
-  if (_Object) {
+  if (_ObjectPrototype) {
     if (!prototype) {
-      prototype = getField(_Object, createString(L"prototype"));
+      prototype = _ObjectPrototype;
       auto err = setConstructor(object, _Object);
       CHECK(this, err);
     }
@@ -291,8 +377,8 @@ JSValue *JSContext::createNativeFunction(
   err = defineProperty(val, createString(L"name"), createString(name), false,
                        false, false);
   CHECK(this, err);
-  if (_Function) {
-    auto prototype = getField(_Function, createString(L"prototype"));
+  if (_FunctionPrototype) {
+    auto prototype = _FunctionPrototype;
     val->getData()->cast<JSCallable>()->setPrototype(prototype->getAtom());
     val->getAtom()->addChild(prototype->getAtom());
     err = defineProperty(val, createString(L"constructor"), _Function, true,
@@ -321,31 +407,18 @@ JSValue *JSContext::createFunction(
   for (auto &[n, atom] : clo) {
     val->getAtom()->addChild(atom);
   }
-  auto prototype = createObject();
-  auto err = defineProperty(val, createString(L"prototype"), prototype, true,
-                            false, true);
-  CHECK(this, err);
-  err = defineProperty(prototype, createString(L"constructor"), val, true,
-                       false, true);
-  CHECK(this, err);
-  err = defineProperty(val, createString(L"name"), createString(name), false,
-                       false, false);
-  CHECK(this, err);
-  if (_Function) {
-    auto prototype = getField(_Function, createString(L"prototype"));
-    val->getData()->cast<JSCallable>()->setPrototype(prototype->getAtom());
-    val->getAtom()->addChild(prototype->getAtom());
-    err = defineProperty(val, createString(L"constructor"), _Function, true,
-                         false, true);
-    CHECK(this, err);
-    err = setConstructor(val, _Function);
+  val->getData()->cast<JSCallable>()->setLazy(true);
+  if (_FunctionPrototype) {
+    val->getData()->cast<JSCallable>()->setPrototype(
+        _FunctionPrototype->getAtom());
+    val->getAtom()->addChild(_FunctionPrototype->getAtom());
+    auto err = setConstructor(val, _Function);
     CHECK(this, err);
   } else {
     auto prototype = createObject();
     val->getData()->cast<JSCallable>()->setPrototype(prototype->getAtom());
     val->getAtom()->addChild(prototype->getAtom());
   }
-  CHECK(this, err);
   return val;
 }
 
@@ -362,23 +435,11 @@ JSValue *JSContext::createGeneratorFunction(
   for (auto &[n, atom] : clo) {
     val->getAtom()->addChild(atom);
   }
-  auto prototype = createObject();
-  auto err = defineProperty(val, createString(L"prototype"), prototype, true,
-                            false, true);
-  CHECK(this, err);
-  err = defineProperty(prototype, createString(L"constructor"), val, true,
-                       false, true);
-  CHECK(this, err);
-  err = defineProperty(val, createString(L"name"), createString(name), false,
-                       false, false);
-  CHECK(this, err);
-  prototype = getField(_GeneratorFunction, createString(L"prototype"));
-  val->getData()->cast<JSCallable>()->setPrototype(prototype->getAtom());
-  val->getAtom()->addChild(prototype->getAtom());
-  err = defineProperty(val, createString(L"constructor"), _GeneratorFunction,
-                       true, false, true);
-  CHECK(this, err);
-  err = setConstructor(val, _GeneratorFunction);
+  val->getData()->cast<JSCallable>()->setLazy(true);
+  val->getData()->cast<JSCallable>()->setPrototype(
+      _GeneratorFunctionPrototype->getAtom());
+  val->getAtom()->addChild(_GeneratorFunctionPrototype->getAtom());
+  auto err = setConstructor(val, _GeneratorFunction);
   CHECK(this, err);
   return val;
 }
@@ -430,8 +491,8 @@ JSValue *JSContext::assigmentValue(JSValue *variable, JSValue *value) {
   return value;
 }
 
-JSValue *JSContext::call(JSValue *func, JSValue *self,
-                         const std::vector<JSValue *> args) {
+JSValue *JSContext::call(JSValue *func, JSValue *self, JSValue *const *argv,
+                         size_t argc) {
   auto type = func->getType()->cast<JSCallableType>();
   if (!type) {
     return createException(JSException::TYPE::TYPE,
@@ -450,33 +511,53 @@ JSValue *JSContext::call(JSValue *func, JSValue *self,
   }
   auto classContext = _classContext;
   _classContext = fn->getClass();
-  auto res = type->call(this, func, self, args);
+  auto res = type->call(this, func, self, {argv, argc});
   _classContext = classContext;
   auto result = current->createValue(res->getAtom());
   popScope();
   return result;
 }
 
-JSValue *JSContext::construct(JSValue *constructor,
-                              const std::vector<JSValue *> &args) {
+JSValue *JSContext::call(JSValue *func, JSValue *self,
+                         const std::vector<JSValue *> &args) {
+  return call(func, self, args.data(), args.size());
+}
+
+JSValue *JSContext::construct(JSValue *constructor, JSValue *const *argv,
+                              size_t argc) {
   CHECK(this, constructor);
-  auto prototype = getField(constructor, createString(L"prototype"));
+  JSValue *prototype = nullptr;
+  if (_Array && constructor->getData() == _Array->getData()) {
+    prototype = _ArrayPrototype;
+  } else if (_Object && constructor->getData() == _Object->getData()) {
+    prototype = _ObjectPrototype;
+  } else {
+    prototype = getField(constructor, createString(L"prototype"));
+  }
   CHECK(this, prototype);
-  JSValue *obj = createObject();
+  JSValue *obj = nullptr;
+  if (prototype->isTypeof<JSObjectType>()) {
+    obj = createObject(prototype);
+  } else {
+    obj = createObject();
+  }
   CHECK(this, obj);
-  auto err = setPrototype(obj, prototype);
-  CHECK(this, err);
-  err = setField(obj, createString(L"constructor"), constructor);
+  auto err = setField(obj, createString(L"constructor"), constructor);
   CHECK(this, err);
   err = setConstructor(obj, constructor);
   CHECK(this, err);
-  auto res = call(constructor, obj, args);
+  auto res = call(constructor, obj, argv, argc);
   if (res->isTypeof<JSObjectType>()) {
     return res;
   }
   return obj;
 }
 
+JSValue *JSContext::construct(JSValue *constructor,
+                              const std::vector<JSValue *> &args) {
+  return construct(constructor, args.data(), args.size());
+}
+
 JSValue *JSContext::getPrototypeOf(JSValue *value) {
   CHECK(this, value);
   if (!value->isTypeof<JSObjectType>()) {
@@ -607,12 +688,41 @@ JSValue *JSContext::getField(JSValue *obj, JSValue *name) {
   CHECK(this, obj);
   auto otype = obj->getType()->cast<JSObjectType>();
   if (!otype) {
-    return createException(JSException::TYPE::TYPE,
-                           L"variable is not a object");
+    if (obj->isTypeof<JSSymbolType>()) {
+      return getField(pack(obj), name);
+    }
+    auto prototype = getPrimitivePrototype(obj);
+    if (!prototype) {
+      return createException(JSException::TYPE::TYPE,
+                             L"variable is not a object");
+    }
+    CHECK(this, prototype);
+    if (obj->isTypeof<JSStringType>()) {
+      auto field =
+          obj->getType()->cast<JSStringType>()->getOwnField(this, obj, name);
+      if (field) {
+        return field;
+      }
+    }
+    return prototype->getType()->cast<JSObjectType>()->getField(
+        this, prototype, name, obj);
   }
   return otype->getField(this, obj, name);
 }
 
+JSValue *JSContext::getPrimitivePrototype(JSValue *value) {
+  if (value->isTypeof<JSStringType>()) {
+    return _StringPrototype;
+  } else if (value->isTypeof<JSNumberType>()) {
+    return _NumberPrototype;
+  } else if (value->isTypeof<JSBooleanType>()) {
+    return _BooleanPrototype;
+  } else if (value->isTypeof<JSBigIntType>()) {
+    return _BigIntPrototype;
+  }
+  return nullptr;
+}
+
 JSValue *JSContext::getKeys(JSValue *obj) {
   CHECK(this, obj);
   auto otype = obj->getType()->cast<JSObjectType>();
@@ -784,6 +894,25 @@ JSValue *JSContext::add(JSValue *left, JSValue *right) {
   }
 }
 
+JSValue *JSContext::concat(const std::vector<JSValue *> &values) {
+  std::vector<JSValue *> parts;
+  parts.reserve(values.size());
+  for (auto value : values) {
+    value = unpack(value);
+    CHECK(this, value);
+    if (value->isTypeof<JSBigIntType>()) {
+      return createException(
+          JSException::TYPE::TYPE,
+          L"Cannot mix BigInt and other types, use explicit conversions");
+    }
+    value = toString(value);
+    CHECK(this, value);
+    parts.push_back(value);
+  }
+  return JSSingleton::instance<JSStringType>(getAllocator())
+      ->concat(this, parts);
+}
+
 JSValue *JSContext::sub(JSValue *left, JSValue *right) {
   left = unpack(left);
   right = unpack(right);
@@ -5,8 +5,12 @@ JSException::JSException(JSAllocator *allocator, const TYPE &type,
                          const std::wstring &message,
                          const std::vector<JSStackFrame> &stack)
     : JSBase(allocator, JSSingleton::instance<JSExceptionType>(allocator)),
-      _message(message), _type(type), _stack(stack){};
+      _message(message), _type(type), _stack(stack) {
+  _mask = MASK;
+};
 
 JSException::JSException(JSAllocator *allocator, JSAtom *value)
     : JSBase(allocator, JSSingleton::instance<JSExceptionType>(allocator)),
-      _value(value) {}
\ No newline at end of file
+      _value(value) {
+  _mask = MASK;
+}
\ No newline at end of file
@@ -3,7 +3,9 @@
 #include "script/engine/JSException.hpp"
 #include "script/engine/JSValue.hpp"
 
-JSExceptionType::JSExceptionType(JSAllocator *allocator) : JSType(allocator) {}
+JSExceptionType::JSExceptionType(JSAllocator *allocator) : JSType(allocator) {
+  _mask = MASK;
+}
 
 const wchar_t *JSExceptionType::getTypeName() const { return L"internal"; }
 JSValue *JSExceptionType::toString(JSContext *ctx, JSValue *value) const {
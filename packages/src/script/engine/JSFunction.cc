@@ -10,4 +10,6 @@ JSFunction::JSFunction(
                  type != nullptr
                      ? type
                      : JSSingleton::instance<JSFunctionType>(allocator)),
-      _path(path), _address(address) {}
\ No newline at end of file
+      _path(path), _address(address) {
+  _mask = MASK;
+}
\ No newline at end of file
@@ -5,20 +5,21 @@
 #include "script/engine/JSValue.hpp"
 #include "script/engine/JSVirtualMachine.hpp"
 JSFunctionType::JSFunctionType(JSAllocator *allocator)
-    : JSCallableType(allocator) {}
+    : JSCallableType(allocator) {
+  _mask = MASK;
+}
 JSValue *JSFunctionType::call(JSContext *ctx, JSValue *func, JSValue *self,
-                              std::vector<JSValue *> args) const {
+                              JSArguments args) const {
   auto current = ctx->getScope();
   auto fn = func->getData()->cast<JSFunction>();
 
   auto runtime = ctx->getRuntime();
   auto vm = runtime->getVirtualMachine();
-  auto program = runtime->getProgram(fn->getProgramPath());
-  std::vector<JSValue *> arguments = {args.rbegin(), args.rend()};
+  auto &program = runtime->getProgram(fn->getProgramPath());
   auto res = vm->eval(ctx, program,
                       {
                           .pc = fn->getAddress(),
-                          .stack = arguments,
+                          .stack = {args.rbegin(), args.rend()},
                           .self = self,
                       });
   res = current->createValue(res->getAtom());
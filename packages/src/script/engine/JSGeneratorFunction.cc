@@ -7,4 +7,6 @@ JSGeneratorFunction::JSGeneratorFunction(
     JSAllocator *allocator, const std::wstring &name, const std::wstring &path,
     size_t address, const std::unordered_map<std::wstring, JSAtom *> &closure)
     : JSFunction(allocator, name, path, address, closure,
-                 JSSingleton::instance<JSGeneratorFunctionType>(allocator)) {}
\ No newline at end of file
+                 JSSingleton::instance<JSGeneratorFunctionType>(allocator)) {
+  _mask = MASK;
+}
\ No newline at end of file
@@ -4,11 +4,13 @@
 #include <vector>
 
 JSGeneratorFunctionType::JSGeneratorFunctionType(JSAllocator *allocator)
-    : JSFunctionType(allocator) {}
+    : JSFunctionType(allocator) {
+  _mask = MASK;
+}
     
 JSValue *JSGeneratorFunctionType::call(JSContext *ctx, JSValue *func,
                                        JSValue *self,
-                                       std::vector<JSValue *> args) const {
+                                       JSArguments args) const {
   auto generator = ctx->construct(ctx->getGeneratorConstructor());
   std::vector<JSAtom *> argv;
   for (auto &arg : args) {
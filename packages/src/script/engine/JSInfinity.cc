@@ -5,6 +5,8 @@
 #include "script/util/JSSingleton.hpp"
 JSInfinity::JSInfinity(JSAllocator *allocator, bool negative)
     : JSBase(allocator, JSSingleton::instance<JSInfinityType>(allocator)),
-      _negative(negative) {}
+      _negative(negative) {
+  _mask = MASK;
+}
 
 bool JSInfinity::isNegative() const { return _negative; }
\ No newline at end of file
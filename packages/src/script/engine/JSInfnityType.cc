@@ -6,7 +6,9 @@
 #include "script/util/JSAllocator.hpp"
 
 JSInfinityType::JSInfinityType(JSAllocator *allocator)
-    : JSNumberType(allocator) {}
+    : JSNumberType(allocator) {
+  _mask = MASK;
+}
 
 JSValue *JSInfinityType::toNumber(JSContext *ctx, JSValue *value) const {
   return value;
@@ -4,4 +4,6 @@
 #include "script/util/JSAllocator.hpp"
 #include "script/util/JSSingleton.hpp"
 JSNaN::JSNaN(JSAllocator *allocator)
-    : JSBase(allocator, JSSingleton::instance<JSNaNType>(allocator)) {}
\ No newline at end of file
+    : JSBase(allocator, JSSingleton::instance<JSNaNType>(allocator)) {
+  _mask = MASK;
+}
\ No newline at end of file
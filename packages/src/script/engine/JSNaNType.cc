@@ -4,7 +4,9 @@
 #include "script/engine/JSValue.hpp"
 #include "script/util/JSAllocator.hpp"
 
-JSNaNType::JSNaNType(JSAllocator *allocator) : JSNumberType(allocator) {}
+JSNaNType::JSNaNType(JSAllocator *allocator) : JSNumberType(allocator) {
+  _mask = MASK;
+}
 JSValue *JSNaNType::toNumber(JSContext *ctx, JSValue *value) const {
   return value;
 }
@@ -7,4 +7,9 @@ JSNativeFunction::JSNativeFunction(
     const std::unordered_map<std::wstring, JSAtom *> &closure)
     : JSCallable(allocator, name, closure,
                  JSSingleton::instance<JSNativeFunctionType>(allocator)),
-      _native(native) {}
+      _native(native), _entry(nullptr) {
+  _mask = MASK;
+  if (auto entry = native.target<JS_NATIVE_ENTRY>()) {
+    _entry = *entry;
+  }
+}
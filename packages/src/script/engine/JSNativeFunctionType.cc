@@ -1,11 +1,16 @@
 #include "script/engine/JSNativeFunctionType.hpp"
 #include "script/engine/JSNativeFunction.hpp"
 JSNativeFunctionType::JSNativeFunctionType(JSAllocator *allocator)
-    : JSCallableType(allocator) {}
+    : JSCallableType(allocator) {
+  _mask = MASK;
+}
     
 JSValue *JSNativeFunctionType::call(JSContext *ctx, JSValue *func,
                                     JSValue *self,
-                                    std::vector<JSValue *> args) const {
+                                    JSArguments args) const {
   auto fn = func->getData()->cast<JSNativeFunction>();
+  if (auto entry = fn->getEntry()) {
+    return entry(ctx, self, args);
+  }
   return fn->getNative()(ctx, self, args);
 }
\ No newline at end of file
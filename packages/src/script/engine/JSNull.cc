@@ -2,4 +2,6 @@
 #include "script/engine/JSNullType.hpp"
 #include "script/util/JSSingleton.hpp"
 JSNull::JSNull(JSAllocator *allocator)
-    : JSBase(allocator, JSSingleton::instance<JSNullType>(allocator)) {}
+    : JSBase(allocator, JSSingleton::instance<JSNullType>(allocator)) {
+  _mask = MASK;
+}
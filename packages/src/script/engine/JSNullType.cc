@@ -3,7 +3,9 @@
 #include "script/engine/JSType.hpp"
 #include "script/engine/JSValue.hpp"
 #include "script/util/JSAllocator.hpp"
-JSNullType::JSNullType(JSAllocator *allocator) : JSType(allocator) {}
+JSNullType::JSNullType(JSAllocator *allocator) : JSType(allocator) {
+  _mask = MASK;
+}
 const wchar_t *JSNullType::getTypeName() const { return L"object"; }
 
 JSValue *JSNullType::toString(JSContext *ctx, JSValue *value) const {
@@ -1,7 +1,23 @@
 #include "script/engine/JSNumber.hpp"
 #include "script/engine/JSNumberType.hpp"
 #include "script/util/JSSingleton.hpp"
+#include <cmath>
 
 JSNumber::JSNumber(JSAllocator *allocator, double value)
-    : JSBase(allocator, JSSingleton::instance<JSNumberType>(allocator)),
-      _value(value) {}
+    : JSBase(allocator, JSSingleton::instance<JSNumberType>(allocator)) {
+  _mask = MASK;
+  setValue(value);
+}
+
+JSNumber::JSNumber(JSAllocator *allocator, int32_t value)
+    : JSBase(allocator, JSSingleton::instance<JSNumberType>(allocator)) {
+  _mask = MASK;
+  setInteger(value);
+}
+
+void JSNumber::setValue(double value) {
+  _value = value;
+  _isInteger = value >= INT32_MIN && value <= INT32_MAX &&
+               value == (int32_t)value && !(value == 0 && std::signbit(value));
+  _integer = _isInteger ? (int32_t)value : 0;
+}
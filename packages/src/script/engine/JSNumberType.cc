@@ -6,14 +6,85 @@
 #include "script/engine/JSNumber.hpp"
 #include "script/engine/JSValue.hpp"
 #include "script/util/JSAllocator.hpp"
+#include <charconv>
+#include <cmath>
 #include <cstdint>
-JSNumberType::JSNumberType(JSAllocator *allocator) : JSType(allocator) {}
+JSNumberType::JSNumberType(JSAllocator *allocator) : JSType(allocator) {
+  _mask = MASK;
+}
 
 const wchar_t *JSNumberType::getTypeName() const { return L"number"; }
 
+std::wstring JSNumberType::format(double value) {
+  if (std::isnan(value)) {
+    return L"NaN";
+  }
+  if (std::isinf(value)) {
+    return value < 0 ? L"-Infinity" : L"Infinity";
+  }
+  if (value == 0) {
+    return L"0";
+  }
+  char buf[32];
+  auto end = std::to_chars(buf, buf + sizeof(buf), value,
+                           std::chars_format::scientific)
+                 .ptr;
+  char *cur = buf;
+  std::wstring result;
+  if (*cur == '-') {
+    result.push_back(L'-');
+    cur++;
+  }
+  char digits[20];
+  int k = 0;
+  while (*cur != 'e') {
+    if (*cur != '.') {
+      digits[k++] = *cur;
+    }
+    cur++;
+  }
+  cur++;
+  int exponent = 0;
+  std::from_chars(*cur == '+' ? cur + 1 : cur, end, exponent);
+  int n = exponent + 1;
+  if (k <= n && n <= 21) {
+    result.append(digits, digits + k);
+    result.append(n - k, L'0');
+  } else if (0 < n && n <= 21) {
+    result.append(digits, digits + n);
+    result.push_back(L'.');
+    result.append(digits + n, digits + k);
+  } else if (-6 < n && n <= 0) {
+    result.append(L"0.");
+    result.append(-n, L'0');
+    result.append(digits, digits + k);
+  } else {
+    result.push_back(digits[0]);
+    if (k > 1) {
+      result.push_back(L'.');
+      result.append(digits + 1, digits + k);
+    }
+    result.push_back(L'e');
+    result.push_back(n - 1 < 0 ? L'-' : L'+');
+    result.append(std::to_wstring(std::abs(n - 1)));
+  }
+  return result;
+}
+
 JSValue *JSNumberType::toString(JSContext *ctx, JSValue *value) const {
   auto number = value->getData()->cast<JSNumber>();
-  return ctx->createString(std::format(L"{}", number->getValue()));
+  if (number->isInteger()) {
+    auto integer = number->getInteger();
+    if (integer >= 0 && integer < SMALL_INTEGER_CACHE_SIZE) {
+      auto &rope = _smallIntegers[integer];
+      if (!rope) {
+        rope = std::make_shared<JSString::Rope>(std::to_wstring(integer));
+      }
+      return ctx->createString(rope);
+    }
+    return ctx->createString(std::to_wstring(integer));
+  }
+  return ctx->createString(format(number->getValue()));
 }
 
 JSValue *JSNumberType::toNumber(JSContext *ctx, JSValue *value) const {
@@ -26,7 +97,11 @@ JSValue *JSNumberType::toBoolean(JSContext *ctx, JSValue *value) const {
 }
 
 JSValue *JSNumberType::clone(JSContext *ctx, JSValue *value) const {
-  return ctx->createNumber(value->getData()->cast<JSNumber>()->getValue());
+  auto number = value->getData()->cast<JSNumber>();
+  if (number->isInteger()) {
+    return ctx->createInteger(number->getInteger());
+  }
+  return ctx->createNumber(number->getValue());
 }
 
 JSValue *JSNumberType::pack(JSContext *ctx, JSValue *value) const {
@@ -49,8 +124,36 @@ JSValue *JSNumberType::equal(JSContext *ctx, JSValue *value,
   return ctx->createBoolean(ctx->checkedNumber(ctx->toNumber(value)) ==
                             ctx->checkedNumber(ctx->toNumber(another)));
 }
+int32_t JSNumberType::toInt32(JSValue *value) const {
+  auto number = value->getData()->cast<JSNumber>();
+  if (!number) {
+    return 0;
+  }
+  if (number->isInteger()) {
+    return number->getInteger();
+  }
+  auto raw = number->getValue();
+  if (!std::isfinite(raw)) {
+    return 0;
+  }
+  auto val = std::fmod(std::trunc(raw), 4294967296.0);
+  if (val < 0) {
+    val += 4294967296.0;
+  }
+  return (int32_t)(uint32_t)val;
+}
+
 JSValue *JSNumberType::add(JSContext *ctx, JSValue *value,
                            JSValue *another) const {
+  auto left = value->getData()->cast<JSNumber>();
+  auto right = another->getData()->cast<JSNumber>();
+  if (left && right && left->isInteger() && right->isInteger()) {
+    int32_t result;
+    if (!__builtin_add_overflow(left->getInteger(), right->getInteger(),
+                                &result)) {
+      return ctx->createInteger(result);
+    }
+  }
   if (another->isTypeof<JSNaNType>() || value->isTypeof<JSNaNType>()) {
     return ctx->createNaN();
   }
@@ -79,6 +182,15 @@ JSValue *JSNumberType::add(JSContext *ctx, JSValue *value,
 
 JSValue *JSNumberType::sub(JSContext *ctx, JSValue *value,
                            JSValue *another) const {
+  auto left = value->getData()->cast<JSNumber>();
+  auto right = another->getData()->cast<JSNumber>();
+  if (left && right && left->isInteger() && right->isInteger()) {
+    int32_t result;
+    if (!__builtin_sub_overflow(left->getInteger(), right->getInteger(),
+                                &result)) {
+      return ctx->createInteger(result);
+    }
+  }
   if (another->isTypeof<JSNaNType>() || value->isTypeof<JSNaNType>()) {
     return ctx->createNaN();
   }
@@ -106,6 +218,17 @@ JSValue *JSNumberType::sub(JSContext *ctx, JSValue *value,
 
 JSValue *JSNumberType::mul(JSContext *ctx, JSValue *value,
                            JSValue *another) const {
+  auto left = value->getData()->cast<JSNumber>();
+  auto right = another->getData()->cast<JSNumber>();
+  if (left && right && left->isInteger() && right->isInteger()) {
+    int32_t result;
+    if (!__builtin_mul_overflow(left->getInteger(), right->getInteger(),
+                                &result) &&
+        (result != 0 ||
+         (left->getInteger() >= 0 && right->getInteger() >= 0))) {
+      return ctx->createInteger(result);
+    }
+  }
   if (another->isTypeof<JSNaNType>() || value->isTypeof<JSNaNType>()) {
     return ctx->createNaN();
   }
@@ -205,72 +328,28 @@ JSValue *JSNumberType::pow(JSContext *ctx, JSValue *value,
 
 JSValue *JSNumberType::and_(JSContext *ctx, JSValue *value,
                             JSValue *another) const {
-  if (value->isTypeof<JSNaNType>() || value->isTypeof<JSInfinityType>()) {
-    return ctx->createNumber(0);
-  }
-  if (another->isTypeof<JSNaNType>() || another->isTypeof<JSInfinityType>()) {
-    return ctx->createNumber(0);
-  }
-
-  return ctx->createNumber((int64_t)ctx->checkedNumber(value) &
-                           (int64_t)ctx->checkedNumber(another));
+  return ctx->createInteger(toInt32(value) & toInt32(another));
 }
 
 JSValue *JSNumberType::or_(JSContext *ctx, JSValue *value,
                            JSValue *another) const {
-  if (value->isTypeof<JSNaNType>() || value->isTypeof<JSInfinityType>()) {
-    if (another->isTypeof<JSNaNType>() || another->isTypeof<JSInfinityType>()) {
-      return ctx->createNumber(0);
-    } else {
-      return another;
-    }
-  }
-  if (another->isTypeof<JSNaNType>() || another->isTypeof<JSInfinityType>()) {
-    return value;
-  }
-
-  return ctx->createNumber((int64_t)ctx->checkedNumber(value) |
-                           (int64_t)ctx->checkedNumber(another));
+  return ctx->createInteger(toInt32(value) | toInt32(another));
 }
 
 JSValue *JSNumberType::xor_(JSContext *ctx, JSValue *value,
                             JSValue *another) const {
-  if (value->isTypeof<JSNaNType>() || value->isTypeof<JSInfinityType>()) {
-    if (another->isTypeof<JSNaNType>() || another->isTypeof<JSInfinityType>()) {
-      return ctx->createNumber(0);
-    } else {
-      return another;
-    }
-  }
-  if (another->isTypeof<JSNaNType>() || another->isTypeof<JSInfinityType>()) {
-    return value;
-  }
-  return ctx->createNumber((int64_t)ctx->checkedNumber(value) ^
-                           (int64_t)ctx->checkedNumber(another));
+  return ctx->createInteger(toInt32(value) ^ toInt32(another));
 }
 
 JSValue *JSNumberType::shr(JSContext *ctx, JSValue *value,
                            JSValue *another) const {
-  if (value->isTypeof<JSNaNType>() || value->isTypeof<JSInfinityType>()) {
-    return ctx->createNumber(0);
-  }
-  if (another->isTypeof<JSNaNType>() || another->isTypeof<JSInfinityType>()) {
-    return value;
-  }
-  return ctx->createNumber((int64_t)ctx->checkedNumber(value) >>
-                           (int64_t)ctx->checkedNumber(another));
+  return ctx->createInteger(toInt32(value) >> (toInt32(another) & 0x1f));
 }
 
 JSValue *JSNumberType::shl(JSContext *ctx, JSValue *value,
                            JSValue *another) const {
-  if (value->isTypeof<JSNaNType>() || value->isTypeof<JSInfinityType>()) {
-    return ctx->createNumber(0);
-  }
-  if (another->isTypeof<JSNaNType>() || another->isTypeof<JSInfinityType>()) {
-    return value;
-  }
-  return ctx->createNumber((int64_t)ctx->checkedNumber(value)
-                           << (int64_t)ctx->checkedNumber(another));
+  return ctx->createInteger(
+      (int32_t)((uint32_t)toInt32(value) << (toInt32(another) & 0x1f)));
 }
 
 JSValue *JSNumberType::gt(JSContext *ctx, JSValue *value,
@@ -382,16 +461,18 @@ JSValue *JSNumberType::le(JSContext *ctx, JSValue *value,
 }
 
 JSValue *JSNumberType::not_(JSContext *ctx, JSValue *value) const {
-  if (value->isTypeof<JSNaNType>() || value->isTypeof<JSInfinityType>()) {
-    return ctx->createNumber(-1);
-  }
-  return ctx->createNumber(~(int64_t)ctx->checkedNumber(value));
+  return ctx->createInteger(~toInt32(value));
 }
 JSValue *JSNumberType::inc(JSContext *ctx, JSValue *value) const {
   if (value->isTypeof<JSNaNType>() || value->isTypeof<JSInfinityType>()) {
     return value;
   }
-  value->getData()->cast<JSNumber>()->setValue(ctx->checkedNumber(value) + 1);
+  auto number = value->getData()->cast<JSNumber>();
+  if (number->isInteger() && number->getInteger() != INT32_MAX) {
+    number->setInteger(number->getInteger() + 1);
+    return value;
+  }
+  number->setValue(number->getValue() + 1);
   return value;
 }
 
@@ -399,7 +480,12 @@ JSValue *JSNumberType::dec(JSContext *ctx, JSValue *value) const {
   if (value->isTypeof<JSNaNType>() || value->isTypeof<JSInfinityType>()) {
     return value;
   }
-  value->getData()->cast<JSNumber>()->setValue(ctx->checkedNumber(value) - 1);
+  auto number = value->getData()->cast<JSNumber>();
+  if (number->isInteger() && number->getInteger() != INT32_MIN) {
+    number->setInteger(number->getInteger() - 1);
+    return value;
+  }
+  number->setValue(number->getValue() - 1);
   return value;
 }
 
@@ -6,4 +6,6 @@ JSObject::JSObject(JSAllocator *allocator, JSType *type)
                             ? JSSingleton::instance<JSObjectType>(allocator)
                             : type),
       _sealed(false), _frozen(false), _extensible(true), _prototype(nullptr),
-      _constructor(nullptr) {}
+      _constructor(nullptr), _opaqueTag(nullptr) {
+  _mask = MASK;
+}
@@ -13,7 +13,9 @@
 #include "script/util/JSAllocator.hpp"
 #include <string>
 
-JSObjectType::JSObjectType(JSAllocator *allocator) : JSType(allocator) {}
+JSObjectType::JSObjectType(JSAllocator *allocator) : JSType(allocator) {
+  _mask = MASK;
+}
 
 const wchar_t *JSObjectType::getTypeName() const { return L"object"; }
 
@@ -32,7 +34,7 @@ JSValue *JSObjectType::toString(JSContext *ctx, JSValue *value) const {
     return ctx->createException(JSException::TYPE::TYPE,
                                 L"'Object' is not function: ");
   }
-  auto prototype = ctx->getField(Object, ctx->createString(L"prototype"));
+  auto prototype = ctx->getObjectPrototype();
   CHECK(ctx, prototype);
   if (!prototype->isTypeof<JSObjectType>()) {
     return ctx->createException(JSException::TYPE::TYPE,
@@ -68,9 +70,14 @@ JSValue *JSObjectType::equal(JSContext *ctx, JSValue *value,
   return ctx->createBoolean(value->getData() == another->getData());
 }
 
+JSValue *JSObjectType::materialize(JSContext *ctx, JSAtom *atom) const {
+  return nullptr;
+}
+
 JSField *JSObjectType::getFieldDescriptor(JSContext *ctx, JSValue *value,
                                           JSValue *name) const {
   JSField *field = nullptr;
+  auto atom = value->getAtom();
   auto object = value->getData()->cast<JSObject>();
   ctx->pushScope();
   while (!field) {
@@ -85,7 +92,8 @@ JSField *JSObjectType::getFieldDescriptor(JSContext *ctx, JSValue *value,
         break;
       }
     }
-    object = object->getPrototype()->getData()->cast<JSObject>();
+    atom = object->getPrototype();
+    object = atom->getData()->cast<JSObject>();
   }
   ctx->popScope();
   return field;
@@ -186,6 +194,8 @@ JSValue *JSObjectType::unpack(JSContext *ctx, JSValue *value) const {
 
 JSValue *JSObjectType::setField(JSContext *ctx, JSValue *object, JSValue *name,
                                 JSValue *value) const {
+  auto err = materialize(ctx, object->getAtom());
+  CHECK(ctx, err);
   ctx->pushScope();
   name = ctx->clone(name);
   if (!name->isTypeof<JSStringType>() && !name->isTypeof<JSSymbolType>()) {
@@ -243,11 +253,17 @@ JSValue *JSObjectType::setField(JSContext *ctx, JSValue *object, JSValue *name,
 }
 
 JSValue *JSObjectType::getField(JSContext *ctx, JSValue *object,
-                                JSValue *name) const {
+                                JSValue *name, JSValue *self) const {
   auto current = ctx->getScope();
   if (!name->isTypeof<JSStringType>() && !name->isTypeof<JSSymbolType>()) {
     name = ctx->toString(name);
   }
+  for (auto atom = object->getAtom(); atom->getData()->cast<JSObject>();
+       atom = atom->getData()->cast<JSObject>()->getPrototype()) {
+    auto err =
+        atom->getData()->getType()->cast<JSObjectType>()->materialize(ctx, atom);
+    CHECK(ctx, err);
+  }
   JSValue *result = nullptr;
   JSField *field = getFieldDescriptor(ctx, object, name);
   if (field) {
@@ -259,7 +275,7 @@ JSValue *JSObjectType::getField(JSContext *ctx, JSValue *object,
         return ctx->createUndefined();
       }
       auto getter = ctx->createValue(field->getter);
-      auto res = ctx->call(getter, object, {});
+      auto res = ctx->call(getter, self ? self : object, {});
       if (res->isTypeof<JSExceptionType>()) {
         return res;
       }
@@ -360,7 +376,8 @@ JSValue *JSObjectType::defineProperty(JSContext *ctx, JSValue *object,
                                       JSValue *name, JSValue *value,
                                       bool configurable, bool enumable,
                                       bool writable) const {
-
+  auto err = materialize(ctx, object->getAtom());
+  CHECK(ctx, err);
   auto obj = object->getData()->cast<JSObject>();
   ctx->pushScope();
   name = ctx->clone(name);
@@ -425,6 +442,8 @@ JSValue *JSObjectType::defineProperty(JSContext *ctx, JSValue *object,
                                       JSValue *name, JSValue *getter,
                                       JSValue *setter, bool configurable,
                                       bool enumable) const {
+  auto err = materialize(ctx, object->getAtom());
+  CHECK(ctx, err);
   auto obj = object->getData()->cast<JSObject>();
   ctx->pushScope();
   if (!name->isTypeof<JSStringType>() && !name->isTypeof<JSSymbolType>()) {
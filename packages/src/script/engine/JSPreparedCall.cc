@@ -0,0 +1,108 @@
+#include "script/engine/JSPreparedCall.hpp"
+#include "script/engine/JSCallable.hpp"
+#include "script/engine/JSInfinity.hpp"
+#include "script/engine/JSInfinityType.hpp"
+#include "script/engine/JSNaNType.hpp"
+#include "script/engine/JSNumberType.hpp"
+#include <cmath>
+#include <limits>
+
+JSPreparedCall::JSPreparedCall(JSContext *ctx, JSValue *func, JSValue *self,
+                               size_t argc)
+    : _ctx(ctx), _self(nullptr), _type(nullptr), _clazz(nullptr),
+      _nan(nullptr), _infinities{nullptr, nullptr} {
+  _scope = ctx->getAllocator()->create<JSScope>(ctx->getRootScope());
+  _func = _scope->createValue(func->getAtom());
+  auto current = ctx->setScope(_scope);
+  auto undefined = ctx->createUndefined();
+  _arguments.resize(argc, undefined);
+  _numbers.resize(argc, nullptr);
+  auto fn = func->getData()->cast<JSCallable>();
+  if (fn) {
+    _type = func->getType()->cast<JSCallableType>();
+    for (auto &[name, atom] : fn->getClosure()) {
+      _scope->storeValue(name, _scope->createValue(atom));
+    }
+    if (fn->getSelf()) {
+      self = _scope->createValue(fn->getSelf());
+    }
+    _clazz = fn->getClass();
+  }
+  _self = self ? _scope->createValue(self->getAtom()) : undefined;
+  ctx->setScope(current);
+}
+
+JSPreparedCall::~JSPreparedCall() { _ctx->getAllocator()->dispose(_scope); }
+
+JSValue *JSPreparedCall::getNonFinite(double value) {
+  auto &slot = std::isnan(value) ? _nan : _infinities[value < 0];
+  if (!slot) {
+    auto current = _ctx->setScope(_scope);
+    slot = std::isnan(value) ? _ctx->createNaN()
+                             : _ctx->createInfinity(value < 0);
+    _ctx->setScope(current);
+  }
+  return slot;
+}
+
+void JSPreparedCall::setArgument(size_t index, double value) {
+  if (!std::isfinite(value)) {
+    _arguments[index] = getNonFinite(value);
+    return;
+  }
+  auto slot = _numbers[index];
+  if (!slot) {
+    slot = _scope->createValue(_ctx->getAllocator()->create<JSNumber>(value));
+    _numbers[index] = slot;
+  } else {
+    slot->getData()->cast<JSNumber>()->setValue(value);
+  }
+  _arguments[index] = slot;
+}
+
+JSValue *JSPreparedCall::run() {
+  if (!_type) {
+    return _ctx->createException(JSException::TYPE::TYPE,
+                                 L"variable is not a function");
+  }
+  auto classContext = _ctx->_classContext;
+  _ctx->_classContext = _clazz;
+  auto res = _type->call(_ctx, _func, _self, _arguments);
+  _ctx->_classContext = classContext;
+  return res;
+}
+
+JSValue *JSPreparedCall::invoke() {
+  auto current = _ctx->setScope(_scope);
+  _ctx->pushScope();
+  auto res = current->createValue(run()->getAtom());
+  _ctx->popScope();
+  _ctx->setScope(current);
+  return res;
+}
+
+JSValue *JSPreparedCall::invoke(double &result) {
+  auto current = _ctx->setScope(_scope);
+  _ctx->pushScope();
+  auto res = run();
+  if (!_ctx->isException(res)) {
+    res = _ctx->toNumber(res);
+  }
+  if (_ctx->isException(res)) {
+    res = current->createValue(res->getAtom());
+  } else {
+    if (res->isTypeof<JSNaNType>()) {
+      result = std::numeric_limits<double>::quiet_NaN();
+    } else if (res->isTypeof<JSInfinityType>()) {
+      result = res->getData()->cast<JSInfinity>()->isNegative()
+                   ? -std::numeric_limits<double>::infinity()
+                   : std::numeric_limits<double>::infinity();
+    } else {
+      result = res->getData()->cast<JSNumber>()->getValue();
+    }
+    res = nullptr;
+  }
+  _ctx->popScope();
+  _ctx->setScope(current);
+  return res;
+}
@@ -1,6 +1,9 @@
 #include "script/engine/JSRuntime.hpp"
 #include "script/engine/JSVirtualMachine.hpp"
+#include <algorithm>
+#include <atomic>
 #include <codecvt>
+#include <thread>
 
 JSRuntime::JSRuntime(int argc, char **argv) {
   std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> convert;
@@ -26,6 +29,10 @@ JSRuntime::~JSRuntime() {
     _allocator->dispose(_logger);
     _logger = nullptr;
   }
+  if (_arena) {
+    _arena->dispose();
+    _arena = nullptr;
+  }
   if (_allocator) {
     _allocator->dispose();
     _allocator = nullptr;
@@ -129,6 +136,43 @@ JSProgram &JSRuntime::getProgram(const std::wstring &path) {
   return program;
 }
 
+JSNode *JSRuntime::createBytecodeError() {
+  auto error = getAllocator()->create<JSErrorNode>();
+  error->message = L"Invalid bytecode";
+  return error;
+}
+
+void JSRuntime::compileProgram(JSParser *parser, JSCodeGenerator *generator,
+                               JSArenaAllocator *arena, JSProgram &program,
+                               const std::wstring &source,
+                               const JS_EVAL_TYPE &type) {
+  auto allocator = parser->getAllocator();
+  parser->setAllocator(arena);
+  auto node = parser->parse(source, type);
+  parser->setAllocator(allocator);
+  if (node->type == JS_NODE_TYPE::ERROR) {
+    auto err = node->cast<JSErrorNode>();
+    auto error = getAllocator()->create<JSErrorNode>();
+    error->message = err->message;
+    error->location = err->location;
+    program.error = error;
+  } else {
+    generator->setLazy(_lazy);
+    auto err = generator->resolve(source, node, program);
+    if (!err && !JSBytecode::verify(program)) {
+      err = createBytecodeError();
+    }
+    if (err) {
+      program.error = err->cast<JSErrorNode>();
+    } else if (program.lazyPending) {
+      program.source = source;
+      program.type = type;
+    }
+  }
+  arena->dispose(node);
+  arena->reset();
+}
+
 JSProgram &JSRuntime::compile(const std::wstring &path,
                               const std::wstring &source,
                               const JS_EVAL_TYPE &type) {
@@ -136,15 +180,177 @@ JSProgram &JSRuntime::compile(const std::wstring &path,
     _programs.erase(path);
   }
   auto &program = getProgram(path);
-  auto node = getParser()->parse(source, type);
+  if (!_arena) {
+    _arena = new JSArenaAllocator{};
+  }
+  compileProgram(getParser(), getGenerator(), _arena, program, source, type);
+  return program;
+}
+
+void JSRuntime::compileAll(
+    const std::vector<std::pair<std::wstring, std::wstring>> &sources,
+    const JS_EVAL_TYPE &type, size_t threads) {
+  auto allocator = getAllocator();
+  std::vector<JSProgram *> programs;
+  for (auto &[path, source] : sources) {
+    _programs.erase(path);
+  }
+  for (auto &[path, source] : sources) {
+    programs.push_back(&getProgram(path));
+  }
+  if (!threads) {
+    threads = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+  threads = std::min(threads, sources.size());
+  std::atomic<size_t> next{0};
+  auto worker = [&]() {
+    JSArenaAllocator arena;
+    JSParser parser(&arena);
+    JSCodeGenerator generator(allocator);
+    for (auto index = next++; index < sources.size(); index = next++) {
+      compileProgram(&parser, &generator, &arena, *programs[index],
+                     sources[index].second, type);
+    }
+  };
+  std::vector<std::thread> workers;
+  for (size_t index = 1; index < threads; index++) {
+    workers.emplace_back(worker);
+  }
+  if (threads) {
+    worker();
+  }
+  for (auto &thread : workers) {
+    thread.join();
+  }
+}
+
+JSNode *JSRuntime::compileFunction(const std::wstring &path, size_t pc) {
+  auto &program = getProgram(path);
+  auto operand = pc + 1;
+  auto index = JSBytecode::readFixed(program.codes.data(), operand);
+  auto &lazy = program.lazyFunctions[index];
+  if (!_arena) {
+    _arena = new JSArenaAllocator{};
+  }
+  auto parser = getParser();
+  auto allocator = parser->getAllocator();
+  parser->setAllocator(_arena);
+  auto node = parser->parseFunction(program.source, lazy.offset, lazy.arrow,
+                                    lazy.closure, program.type);
+  parser->setAllocator(allocator);
+  JSNode *error = nullptr;
   if (node->type == JS_NODE_TYPE::ERROR) {
-    program.error = node->cast<JSErrorNode>();
-    return program;
+    auto err = node->cast<JSErrorNode>();
+    auto copy = getAllocator()->create<JSErrorNode>();
+    copy->message = err->message;
+    copy->location = err->location;
+    error = copy;
+  } else {
+    auto generator = getGenerator();
+    generator->setLazy(_lazy);
+    auto address = program.codes.size();
+    auto lazyCount = program.lazyFunctions.size();
+    auto lazyPending = program.lazyPending;
+    error =
+        generator->resolveFunctionDeclaration(program.source, node, program);
+    if (!error && !JSBytecode::verify(program, address)) {
+      error = createBytecodeError();
+    }
+    if (error) {
+      program.codes.resize(address);
+      program.positions.truncate(address);
+      program.lazyFunctions.resize(lazyCount);
+      program.lazyPending = lazyPending;
+    } else {
+      program.codes[pc] = (uint8_t)JS_OPERATOR::JMP;
+      JSBytecode::setAddress(program.codes, pc + 1, address);
+      if (!--program.lazyPending) {
+        program.source.clear();
+        program.source.shrink_to_fit();
+      }
+    }
+  }
+  _arena->dispose(node);
+  _arena->reset();
+  return error;
+}
+
+JSNode *JSRuntime::compileChunk(const std::wstring &path,
+                                JSStreamState &stream, bool final) {
+  if (!stream.started) {
+    _programs.erase(path);
+    stream.started = true;
   }
-  auto err = getGenerator()->resolve(source, node, program);
-  getAllocator()->dispose(node);
-  if (err) {
-    program.error = err->cast<JSErrorNode>();
+  auto &program = getProgram(path);
+  if (!_arena) {
+    _arena = new JSArenaAllocator{};
   }
-  return program;
-}
\ No newline at end of file
+  auto parser = getParser();
+  auto allocator = parser->getAllocator();
+  parser->setAllocator(_arena);
+  auto node = parser->parseChunk(stream.buffer, stream.declared, stream.line,
+                                 stream.type);
+  size_t end = 0;
+  std::wstring head;
+  const std::wstring *source = &stream.buffer;
+  if (node->type != JS_NODE_TYPE::ERROR) {
+    auto &statements = node->cast<JSProgramNode>()->statements;
+    if (final) {
+      end = stream.buffer.size();
+    } else if (statements.size() > 1) {
+      end = statements.back()->location.start.offset;
+      head = stream.buffer.substr(0, end);
+      source = &head;
+      _arena->dispose(node);
+      _arena->reset();
+      node = parser->parseChunk(head, stream.declared, stream.line,
+                                stream.type);
+    }
+  }
+  parser->setAllocator(allocator);
+  JSNode *error = nullptr;
+  if (node->type == JS_NODE_TYPE::ERROR) {
+    if (final || end) {
+      auto err = node->cast<JSErrorNode>();
+      auto copy = getAllocator()->create<JSErrorNode>();
+      copy->message = err->message;
+      copy->location = err->location;
+      error = copy;
+    }
+  } else if (end) {
+    if (!node->cast<JSProgramNode>()->statements.empty()) {
+      auto generator = getGenerator();
+      generator->setLazy(false);
+      auto pc = program.codes.size();
+      error = generator->resolveChunk(*source, node, program, pc == 0);
+      if (!error && !JSBytecode::verify(program, pc)) {
+        error = createBytecodeError();
+      }
+    }
+    if (!error) {
+      for (auto &declar : node->scope->declarations) {
+        stream.declared.insert(declar.name);
+      }
+      size_t start = 0;
+      size_t carriages = 0;
+      for (size_t offset = 0; offset < end; offset++) {
+        auto c = stream.buffer[offset];
+        if (c == '\r') {
+          carriages++;
+        } else if (JSTokenizer::isLineTerminator(c)) {
+          stream.line++;
+          start = offset + 1;
+          carriages = 0;
+        }
+      }
+      if (end == stream.buffer.size()) {
+        stream.buffer.clear();
+      } else {
+        stream.buffer.replace(0, end, end - start - carriages, L' ');
+      }
+    }
+  }
+  _arena->dispose(node);
+  _arena->reset();
+  return error;
+}
@@ -3,8 +3,63 @@
 #include "script/engine/JSStringType.hpp"
 #include "script/util/JSAllocator.hpp"
 #include "script/util/JSSingleton.hpp"
+#include <memory>
 #include <string>
+#include <vector>
+
+JSString::Rope::~Rope() {
+  std::vector<std::shared_ptr<Rope>> workflow;
+  if (left) {
+    workflow.push_back(std::move(left));
+  }
+  if (right) {
+    workflow.push_back(std::move(right));
+  }
+  while (!workflow.empty()) {
+    auto node = std::move(workflow.back());
+    workflow.pop_back();
+    if (node.use_count() == 1) {
+      if (node->left) {
+        workflow.push_back(std::move(node->left));
+      }
+      if (node->right) {
+        workflow.push_back(std::move(node->right));
+      }
+    }
+  }
+}
+
+const std::wstring &JSString::Rope::flatten() {
+  if (isFlat()) {
+    return value;
+  }
+  std::wstring result;
+  result.reserve(length);
+  std::vector<Rope *> workflow = {this};
+  while (!workflow.empty()) {
+    auto node = workflow.back();
+    workflow.pop_back();
+    if (node->isFlat()) {
+      result.append(node->value);
+    } else {
+      workflow.push_back(node->right.get());
+      workflow.push_back(node->left.get());
+    }
+  }
+  value = std::move(result);
+  left = nullptr;
+  right = nullptr;
+  return value;
+}
 
 JSString::JSString(JSAllocator *allocator, const std::wstring &value)
     : JSBase(allocator, JSSingleton::instance<JSStringType>(allocator)),
-      _value(value) {}
\ No newline at end of file
+      _rope(std::make_shared<Rope>(value)) {
+  _mask = MASK;
+}
+
+JSString::JSString(JSAllocator *allocator, const std::shared_ptr<Rope> &rope)
+    : JSBase(allocator, JSSingleton::instance<JSStringType>(allocator)),
+      _rope(rope) {
+  _mask = MASK;
+}
@@ -1,26 +1,189 @@
 #include "script/engine/JSStringType.hpp"
 #include "script/engine/JSContext.hpp"
+#include "script/engine/JSInfinityType.hpp"
+#include "script/engine/JSNaNType.hpp"
+#include "script/engine/JSNumberType.hpp"
 #include "script/engine/JSString.hpp"
 #include "script/engine/JSType.hpp"
 #include "script/util/JSAllocator.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <locale.h>
+#include <memory>
 #include <string>
-JSStringType::JSStringType(JSAllocator *allocator) : JSType(allocator) {}
+#include <string_view>
+JSStringType::JSStringType(JSAllocator *allocator) : JSType(allocator) {
+  _mask = MASK;
+}
 
 const wchar_t *JSStringType::getTypeName() const { return L"string"; }
 
 JSValue *JSStringType::toString(JSContext *ctx, JSValue *value) const {
-  return ctx->createString(value->getData()->cast<JSString>()->getValue());
+  return value;
+}
+
+bool JSStringType::isWhiteSpace(wchar_t chr) {
+  switch (chr) {
+  case 0x9:
+  case 0xa:
+  case 0xb:
+  case 0xc:
+  case 0xd:
+  case 0x20:
+  case 0xa0:
+  case 0x1680:
+  case 0x2028:
+  case 0x2029:
+  case 0x202f:
+  case 0x205f:
+  case 0x3000:
+  case 0xfeff:
+    return true;
+  default:
+    return chr >= 0x2000 && chr <= 0x200a;
+  }
+}
+
+double JSStringType::parseNumber(const std::wstring &source) {
+  static constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+  static constexpr double Infinity = std::numeric_limits<double>::infinity();
+  auto begin = source.data();
+  auto end = begin + source.length();
+  while (begin != end && isWhiteSpace(*begin)) {
+    begin++;
+  }
+  while (end != begin && isWhiteSpace(*(end - 1))) {
+    end--;
+  }
+  if (begin == end) {
+    return 0;
+  }
+  if (end - begin > 2 && begin[0] == L'0') {
+    int radix = 0;
+    switch (begin[1]) {
+    case L'x':
+    case L'X':
+      radix = 16;
+      break;
+    case L'o':
+    case L'O':
+      radix = 8;
+      break;
+    case L'b':
+    case L'B':
+      radix = 2;
+      break;
+    }
+    if (radix) {
+      double result = 0;
+      for (auto cur = begin + 2; cur != end; cur++) {
+        int digit = radix;
+        if (*cur >= L'0' && *cur <= L'9') {
+          digit = *cur - L'0';
+        } else if (*cur >= L'a' && *cur <= L'f') {
+          digit = *cur - L'a' + 10;
+        } else if (*cur >= L'A' && *cur <= L'F') {
+          digit = *cur - L'A' + 10;
+        }
+        if (digit >= radix) {
+          return NaN;
+        }
+        result = result * radix + digit;
+      }
+      return result;
+    }
+  }
+  bool negative = false;
+  if (*begin == L'+' || *begin == L'-') {
+    negative = *begin == L'-';
+    begin++;
+  }
+  if (std::wstring_view(begin, end - begin) == L"Infinity") {
+    return negative ? -Infinity : Infinity;
+  }
+  char buf[128];
+  std::string large;
+  char *output = buf;
+  if (end - begin >= (ptrdiff_t)sizeof(buf)) {
+    large.resize(end - begin + 1);
+    output = large.data();
+  }
+  size_t length = 0;
+  size_t digits = 0;
+  // decimal order of the first significant digit plus the exponent; its
+  // sign tells overflow from underflow when the value is out of range
+  ptrdiff_t order = 0;
+  bool significant = false;
+  auto cur = begin;
+  while (cur != end && *cur >= L'0' && *cur <= L'9') {
+    significant = significant || *cur != L'0';
+    order += significant;
+    output[length++] = (char)*cur++;
+    digits++;
+  }
+  if (cur != end && *cur == L'.') {
+    output[length++] = (char)*cur++;
+    while (cur != end && *cur >= L'0' && *cur <= L'9') {
+      significant = significant || *cur != L'0';
+      order -= !significant;
+      output[length++] = (char)*cur++;
+      digits++;
+    }
+  }
+  if (!digits) {
+    return NaN;
+  }
+  if (cur != end && (*cur == L'e' || *cur == L'E')) {
+    output[length++] = (char)*cur++;
+    bool negativeExponent = false;
+    if (cur != end && (*cur == L'+' || *cur == L'-')) {
+      negativeExponent = *cur == L'-';
+      output[length++] = (char)*cur++;
+    }
+    if (cur == end) {
+      return NaN;
+    }
+    ptrdiff_t exponent = 0;
+    while (cur != end && *cur >= L'0' && *cur <= L'9') {
+      exponent = std::min<ptrdiff_t>(exponent * 10 + (*cur - L'0'), 1 << 24);
+      output[length++] = (char)*cur++;
+    }
+    order += negativeExponent ? -exponent : exponent;
+  }
+  if (cur != end) {
+    return NaN;
+  }
+  output[length] = 0;
+  double result = 0;
+  auto res = std::from_chars(output, output + length, result);
+  if (res.ec == std::errc::result_out_of_range) {
+    // from_chars also refuses subnormals, so only the orders that are past
+    // the double range for sure are settled here
+    if (order > 309) {
+      result = Infinity;
+    } else if (order < -323) {
+      result = 0;
+    } else {
+      static locale_t locale = newlocale(LC_ALL_MASK, "C", nullptr);
+      result = strtod_l(output, nullptr, locale);
+    }
+  }
+  return negative ? -result : result;
 }
 
 JSValue *JSStringType::toNumber(JSContext *ctx, JSValue *value) const {
   CHECK(ctx, value);
-  auto str = ctx->checkedString(value);
-  if ((str[0] >= '0' && str[0] <= '9') ||
-      (str[0] == '.' && str[1] >= '0' && str[1] <= '9')) {
-    return ctx->createNumber(std::stod(str));
-  } else {
+  auto result = parseNumber(ctx->checkedString(value));
+  if (std::isnan(result)) {
     return ctx->createNaN();
   }
+  if (std::isinf(result)) {
+    return ctx->createInfinity(result < 0);
+  }
+  return ctx->createNumber(result);
 };
 
 JSValue *JSStringType::toBoolean(JSContext *ctx, JSValue *value) const {
@@ -29,7 +192,7 @@ JSValue *JSStringType::toBoolean(JSContext *ctx, JSValue *value) const {
 };
 
 JSValue *JSStringType::clone(JSContext *ctx, JSValue *value) const {
-  return ctx->createString(value->getData()->cast<JSString>()->getValue());
+  return ctx->createString(value->getData()->cast<JSString>()->getRope());
 }
 JSValue *JSStringType::pack(JSContext *ctx, JSValue *value) const {
   auto String = ctx->getStringConstructor();
@@ -42,10 +205,53 @@ JSValue *JSStringType::equal(JSContext *ctx, JSValue *value,
   return ctx->createBoolean(ctx->checkedString(value) ==
                             ctx->checkedString(another));
 }
+JSValue *JSStringType::getOwnField(JSContext *ctx, JSValue *value,
+                                   JSValue *name) const {
+  auto str = value->getData()->cast<JSString>();
+  if (name->isTypeof<JSNumberType>() && !name->isTypeof<JSNaNType>() &&
+      !name->isTypeof<JSInfinityType>()) {
+    auto num = ctx->checkedNumber(name);
+    size_t idx = (size_t)num;
+    if (idx == num && idx < str->getLength()) {
+      return ctx->createString(std::wstring(1, str->getValue()[idx]));
+    }
+    return nullptr;
+  }
+  if (ctx->checkedString(name) == L"length") {
+    return ctx->createNumber(str->getLength());
+  }
+  return nullptr;
+}
+
 JSValue *JSStringType::add(JSContext *ctx, JSValue *value,
                            JSValue *another) const {
   CHECK(ctx, value);
   CHECK(ctx, another);
-  return ctx->createString(ctx->checkedString(value) +
-                           ctx->checkedString(another));
+  auto &left = value->getData()->cast<JSString>()->getRope();
+  auto &right = another->getData()->cast<JSString>()->getRope();
+  if (left->length == 0) {
+    return ctx->createString(right);
+  }
+  if (right->length == 0) {
+    return ctx->createString(left);
+  }
+  if (left->length + right->length <= MIN_ROPE_LENGTH) {
+    return ctx->createString(left->flatten() + right->flatten());
+  }
+  return ctx->createString(std::make_shared<JSString::Rope>(left, right));
+}
+
+JSValue *JSStringType::concat(JSContext *ctx,
+                              const std::vector<JSValue *> &values) const {
+  size_t length = 0;
+  for (auto value : values) {
+    CHECK(ctx, value);
+    length += value->getData()->cast<JSString>()->getLength();
+  }
+  std::wstring result;
+  result.reserve(length);
+  for (auto value : values) {
+    result.append(value->getData()->cast<JSString>()->getValue());
+  }
+  return ctx->createString(std::make_shared<JSString::Rope>(std::move(result)));
 }
\ No newline at end of file
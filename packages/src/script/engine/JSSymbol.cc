@@ -7,4 +7,6 @@
 
 JSSymbol::JSSymbol(JSAllocator *allocator, const std::wstring &description)
     : JSBase(allocator, JSSingleton::instance<JSSymbolType>(allocator)),
-      _description(description) {}
\ No newline at end of file
+      _description(description) {
+  _mask = MASK;
+}
\ No newline at end of file
@@ -4,7 +4,9 @@
 #include "script/engine/JSSymbol.hpp"
 #include "script/engine/JSValue.hpp"
 #include "script/util/JSAllocator.hpp"
-JSSymbolType::JSSymbolType(JSAllocator *allocator) : JSType(allocator) {}
+JSSymbolType::JSSymbolType(JSAllocator *allocator) : JSType(allocator) {
+  _mask = MASK;
+}
 const wchar_t *JSSymbolType::getTypeName() const { return L"symbol"; }
 JSValue *JSSymbolType::toString(JSContext *ctx, JSValue *value) const {
   return ctx->createException(JSException::TYPE::TYPE,
@@ -25,7 +27,7 @@ JSValue *JSSymbolType::clone(JSContext *ctx, JSValue *value) const {
 }
 JSValue *JSSymbolType::pack(JSContext *ctx, JSValue *value) const {
   auto Symbol = ctx->getSymbolConstructor();
-  auto prototype = ctx->getField(Symbol, ctx->createString(L"prototype"));
+  auto prototype = ctx->getSymbolPrototype();
   CHECK(ctx, prototype);
   auto object = ctx->createObject(prototype);
   CHECK(ctx, object);
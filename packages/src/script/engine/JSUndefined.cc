@@ -4,4 +4,6 @@
 #include "script/util/JSAllocator.hpp"
 #include "script/util/JSSingleton.hpp"
 JSUndefined::JSUndefined(JSAllocator *allocator)
-    : JSBase(allocator, JSSingleton::instance<JSUndefinedType>(allocator)) {}
\ No newline at end of file
+    : JSBase(allocator, JSSingleton::instance<JSUndefinedType>(allocator)) {
+  _mask = MASK;
+}
\ No newline at end of file
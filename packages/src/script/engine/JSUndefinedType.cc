@@ -2,7 +2,9 @@
 #include "script/engine/JSContext.hpp"
 #include "script/engine/JSType.hpp"
 #include "script/util/JSAllocator.hpp"
-JSUndefinedType::JSUndefinedType(JSAllocator *allocator) : JSType(allocator) {}
+JSUndefinedType::JSUndefinedType(JSAllocator *allocator) : JSType(allocator) {
+  _mask = MASK;
+}
 
 const wchar_t *JSUndefinedType::getTypeName() const { return L"undefined"; }
 
@@ -5,4 +5,6 @@
 #include "script/util/JSSingleton.hpp"
 
 JSUninitialize::JSUninitialize(JSAllocator *allocator)
-    : JSBase(allocator, JSSingleton::instance<JSUninitializeType>(allocator)) {}
\ No newline at end of file
+    : JSBase(allocator, JSSingleton::instance<JSUninitializeType>(allocator)) {
+  _mask = MASK;
+}
\ No newline at end of file
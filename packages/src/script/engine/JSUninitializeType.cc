@@ -4,7 +4,9 @@
 #include "script/engine/JSValue.hpp"
 #include "script/util/JSAllocator.hpp"
 JSUninitializeType::JSUninitializeType(JSAllocator *allocator)
-    : JSType(allocator) {}
+    : JSType(allocator) {
+  _mask = MASK;
+}
 const wchar_t *JSUninitializeType::getTypeName() const {
   return L"uninitialized";
 }
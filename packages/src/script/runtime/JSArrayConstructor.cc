@@ -26,7 +26,7 @@ JSValue *JSArrayConstructor::initialize(JSContext *ctx) {
   return Array;
 }
 JSValue *JSArrayConstructor::constructor(JSContext *ctx, JSValue *self,
-                                         std::vector<JSValue *> args) {
+                                         JSArguments args) {
   auto array =
       ctx->getScope()->createValue(ctx->getAllocator()->create<JSArray>());
   auto constructor = ctx->getArrayConstructor();
@@ -40,7 +40,7 @@ JSValue *JSArrayConstructor::constructor(JSContext *ctx, JSValue *self,
 }
 
 JSValue *JSArrayConstructor::toString(JSContext *ctx, JSValue *self,
-                                      std::vector<JSValue *> args) {
+                                      JSArguments args) {
   auto arr = self->getData()->cast<JSArray>();
   auto &items = arr->getItems();
   std::wstring result;
@@ -11,7 +11,7 @@
 #include <vector>
 
 JSValue *JSBigIntConstructor::constructor(JSContext *ctx, JSValue *self,
-                                          std::vector<JSValue *> args) {
+                                          JSArguments args) {
   JSValue *value = nullptr;
   if (args.empty()) {
     value = ctx->createUndefined();
@@ -35,7 +35,10 @@ JSValue *JSBigIntConstructor::constructor(JSContext *ctx, JSValue *self,
   return ctx->createUndefined();
 }
 JSValue *JSBigIntConstructor::toString(JSContext *ctx, JSValue *self,
-                                       std::vector<JSValue *> args) {
+                                       JSArguments args) {
+  if (self->isTypeof<JSBigIntType>()) {
+    return ctx->toString(self);
+  }
   if (!self->isTypeof<JSObjectType>()) {
     return ctx->createException(
         JSException::TYPE::TYPE,
@@ -58,7 +61,10 @@ JSValue *JSBigIntConstructor::toString(JSContext *ctx, JSValue *self,
 }
 
 JSValue *JSBigIntConstructor::valueOf(JSContext *ctx, JSValue *self,
-                                      std::vector<JSValue *> args) {
+                                      JSArguments args) {
+  if (self->isTypeof<JSBigIntType>()) {
+    return self;
+  }
   if (!self->isTypeof<JSObjectType>()) {
     return ctx->createException(
         JSException::TYPE::TYPE,
@@ -1,4 +1,5 @@
 #include "script/runtime/JSBooleanConstructor.hpp"
+#include "script/engine/JSBooleanType.hpp"
 #include "script/engine/JSContext.hpp"
 #include "script/engine/JSException.hpp"
 #include "script/engine/JSObject.hpp"
@@ -6,7 +7,7 @@
 #include "script/engine/JSValue.hpp"
 #include <vector>
 JSValue *JSBooleanConstructor::constructor(JSContext *ctx, JSValue *self,
-                                           std::vector<JSValue *> args) {
+                                           JSArguments args) {
   JSValue *value = nullptr;
   if (args.empty()) {
     value = ctx->createUndefined();
@@ -22,7 +23,10 @@ JSValue *JSBooleanConstructor::constructor(JSContext *ctx, JSValue *self,
   return ctx->createUndefined();
 }
 JSValue *JSBooleanConstructor::toString(JSContext *ctx, JSValue *self,
-                                        std::vector<JSValue *> args) {
+                                        JSArguments args) {
+  if (self->isTypeof<JSBooleanType>()) {
+    return ctx->toString(self);
+  }
   if (!self->isTypeof<JSObjectType>()) {
     return ctx->createException(
         JSException::TYPE::TYPE,
@@ -45,7 +49,10 @@ JSValue *JSBooleanConstructor::toString(JSContext *ctx, JSValue *self,
 }
 
 JSValue *JSBooleanConstructor::valueOf(JSContext *ctx, JSValue *self,
-                                       std::vector<JSValue *> args) {
+                                       JSArguments args) {
+  if (self->isTypeof<JSBooleanType>()) {
+    return self;
+  }
   if (!self->isTypeof<JSObjectType>()) {
     return ctx->createException(
         JSException::TYPE::TYPE,
@@ -3,12 +3,12 @@
 #include "script/engine/JSValue.hpp"
 
 JSValue *JSFunctionConstructor::constructor(JSContext *ctx, JSValue *self,
-                                            std::vector<JSValue *> args) {
+                                            JSArguments args) {
   return nullptr;
 }
 
 JSValue *JSFunctionConstructor::toString(JSContext *ctx, JSValue *self,
-                                         std::vector<JSValue *> args) {
+                                         JSArguments args) {
   auto callable = self->getData()->cast<JSCallable>();
   auto name = callable->getName();
   if (name.empty()) {
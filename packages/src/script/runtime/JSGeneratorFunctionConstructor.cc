@@ -4,7 +4,7 @@
 #include <vector>
 JSValue *
 JSGeneratorFunctionConstructor::constructor(JSContext *ctx, JSValue *value,
-                                            std::vector<JSValue *> args) {
+                                            JSArguments args) {
   return ctx->createUndefined();
 }
 
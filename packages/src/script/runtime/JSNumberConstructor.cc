@@ -1,13 +1,14 @@
 #include "script/runtime/JSNumberConstructor.hpp"
 #include "script/engine/JSContext.hpp"
 #include "script/engine/JSException.hpp"
+#include "script/engine/JSNumberType.hpp"
 #include "script/engine/JSObject.hpp"
 #include "script/engine/JSObjectType.hpp"
 #include "script/engine/JSValue.hpp"
 #include <vector>
 
 JSValue *JSNumberConstructor::constructor(JSContext *ctx, JSValue *self,
-                                          std::vector<JSValue *> args) {
+                                          JSArguments args) {
   JSValue *value = nullptr;
   if (args.empty()) {
     value = ctx->createUndefined();
@@ -23,7 +24,10 @@ JSValue *JSNumberConstructor::constructor(JSContext *ctx, JSValue *self,
   return ctx->createUndefined();
 }
 JSValue *JSNumberConstructor::toString(JSContext *ctx, JSValue *self,
-                                       std::vector<JSValue *> args) {
+                                       JSArguments args) {
+  if (self->isTypeof<JSNumberType>()) {
+    return ctx->toString(self);
+  }
   if (!self->isTypeof<JSObjectType>()) {
     return ctx->createException(
         JSException::TYPE::TYPE,
@@ -46,7 +50,10 @@ JSValue *JSNumberConstructor::toString(JSContext *ctx, JSValue *self,
 }
 
 JSValue *JSNumberConstructor::valueOf(JSContext *ctx, JSValue *self,
-                                      std::vector<JSValue *> args) {
+                                      JSArguments args) {
+  if (self->isTypeof<JSNumberType>()) {
+    return self;
+  }
   if (!self->isTypeof<JSObjectType>()) {
     return ctx->createException(
         JSException::TYPE::TYPE,
@@ -7,11 +7,11 @@
 #include "script/engine/JSValue.hpp"
 #include <vector>
 JSValue *JSObjectConstructor::constructor(JSContext *ctx, JSValue *self,
-                                          std::vector<JSValue *> args) {
+                                          JSArguments args) {
   return nullptr;
 }
 JSValue *JSObjectConstructor::toString(JSContext *ctx, JSValue *value,
-                                       std::vector<JSValue *> args) {
+                                       JSArguments args) {
   std::wstring name;
   ctx->pushScope();
   auto prototype = ctx->getPrototypeOf(value);
@@ -3,11 +3,12 @@
 #include "script/engine/JSException.hpp"
 #include "script/engine/JSObject.hpp"
 #include "script/engine/JSObjectType.hpp"
+#include "script/engine/JSStringType.hpp"
 #include "script/engine/JSValue.hpp"
 #include <vector>
 
 JSValue *JSStringConstructor::constructor(JSContext *ctx, JSValue *self,
-                                          std::vector<JSValue *> args) {
+                                          JSArguments args) {
   JSValue *value = nullptr;
   if (args.empty()) {
     value = ctx->createUndefined();
@@ -23,7 +24,10 @@ JSValue *JSStringConstructor::constructor(JSContext *ctx, JSValue *self,
   return ctx->createUndefined();
 }
 JSValue *JSStringConstructor::toString(JSContext *ctx, JSValue *self,
-                                       std::vector<JSValue *> args) {
+                                       JSArguments args) {
+  if (self->isTypeof<JSStringType>()) {
+    return ctx->toString(self);
+  }
   if (!self->isTypeof<JSObjectType>()) {
     return ctx->createException(
         JSException::TYPE::TYPE,
@@ -46,7 +50,10 @@ JSValue *JSStringConstructor::toString(JSContext *ctx, JSValue *self,
 }
 
 JSValue *JSStringConstructor::valueOf(JSContext *ctx, JSValue *self,
-                                      std::vector<JSValue *> args) {
+                                      JSArguments args) {
+  if (self->isTypeof<JSStringType>()) {
+    return self;
+  }
   if (!self->isTypeof<JSObjectType>()) {
     return ctx->createException(
         JSException::TYPE::TYPE,
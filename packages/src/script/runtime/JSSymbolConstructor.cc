@@ -7,7 +7,7 @@
 #include <string>
 #include <vector>
 JSValue *JSSymbolConstructor::toString(JSContext *ctx, JSValue *self,
-                                       std::vector<JSValue *> args) {
+                                       JSArguments args) {
   auto description = ctx->getField(self, ctx->createString(L"description"));
   CHECK(ctx, description);
   auto str = ctx->checkedString(description);
@@ -15,7 +15,7 @@ JSValue *JSSymbolConstructor::toString(JSContext *ctx, JSValue *self,
 }
 
 JSValue *JSSymbolConstructor::constructor(JSContext *ctx, JSValue *self,
-                                          std::vector<JSValue *> args) {
+                                          JSArguments args) {
   if (!args.empty()) {
     auto arg = ctx->toString(args[0]);
     CHECK(ctx, arg);
@@ -24,11 +24,11 @@ JSValue *JSSymbolConstructor::constructor(JSContext *ctx, JSValue *self,
   return ctx->createSymbol();
 }
 JSValue *JSSymbolConstructor::toPrimitive(JSContext *ctx, JSValue *self,
-                                          std::vector<JSValue *> args) {
+                                          JSArguments args) {
   return ctx->getMetadata(self, L"primitive");
 }
 JSValue *JSSymbolConstructor::for_(JSContext *ctx, JSValue *self,
-                                   std::vector<JSValue *> args) {
+                                   JSArguments args) {
   auto Symbol = ctx->getSymbolConstructor();
   auto map = ctx->getMetadata(Symbol, L"globalSymbolMap");
   if (!map) {
@@ -54,7 +54,7 @@ JSValue *JSSymbolConstructor::for_(JSContext *ctx, JSValue *self,
 }
 
 JSValue *JSSymbolConstructor::keyFor(JSContext *ctx, JSValue *self,
-                                     std::vector<JSValue *> args) {
+                                     JSArguments args) {
   auto Symbol = ctx->getSymbolConstructor();
   auto map = ctx->getMetadata(Symbol, L"globalSymbolMap");
   if (!map) {
@@ -0,0 +1,58 @@
+#include "script/compiler/JSParser.hpp"
+#include "script/util/JSArenaAllocator.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+// parser throughput: benchmark <file.js> [iterations]
+int main(int argc, char *argv[]) {
+  if (argc < 2) {
+    std::cerr << "usage: " << argv[0] << " <file.js> [iterations]"
+              << std::endl;
+    return -1;
+  }
+  size_t iterations = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 10;
+  std::wifstream file(argv[1], std::ios::binary | std::ios::in);
+  if (!file) {
+    std::cerr << "cannot open " << argv[1] << std::endl;
+    return -1;
+  }
+  file.seekg(0, std::ios::end);
+  size_t size = file.tellg();
+  file.seekg(0, std::ios::beg);
+  auto buf = new wchar_t[size + 1];
+  file.read(buf, size);
+  file.close();
+  buf[size] = 0;
+  std::wstring source = buf;
+  delete[] buf;
+
+  auto allocator = new JSAllocator();
+  auto arena = new JSArenaAllocator();
+  auto parser = allocator->create<JSParser>();
+  parser->setAllocator(arena);
+  auto start = std::chrono::steady_clock::now();
+  for (size_t index = 0; index < iterations; index++) {
+    auto node = parser->parse(source);
+    if (node->type == JS_NODE_TYPE::ERROR) {
+      auto err = node->cast<JSErrorNode>();
+      std::wcerr << err->message << L" at " << err->location.end.line << L":"
+                 << err->location.end.column << std::endl;
+      return -1;
+    }
+    arena->dispose(node);
+    arena->reset();
+  }
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  auto megabytes = (double)size * iterations / (1024 * 1024);
+  std::cout << "parsed " << size << " bytes x " << iterations << " in "
+            << elapsed.count() << "s: " << megabytes / elapsed.count()
+            << " MB/s" << std::endl;
+  allocator->dispose(parser);
+  arena->dispose();
+  allocator->dispose();
+  return 0;
+}
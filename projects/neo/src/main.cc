@@ -13,7 +13,7 @@
 #include <windows.h>
 #endif
 
-JSValue *print(JSContext *ctx, JSValue *self, std::vector<JSValue *> args) {
+JSValue *print(JSContext *ctx, JSValue *self, JSArguments args) {
   for (auto &arg : args) {
     auto str = ctx->toString(ctx->pack(arg));
     CHECK(ctx, str);
@@ -0,0 +1,66 @@
+#include "script/compiler/JSBytecode.hpp"
+#include "script/compiler/JSProgram.hpp"
+#include "script/engine/JSRuntime.hpp"
+#include <gtest/gtest.h>
+
+TEST(TestBytecode, varint) {
+  std::vector<uint8_t> codes;
+  for (uint32_t value : {0u, 127u, 128u, 300u, UINT32_MAX}) {
+    JSBytecode::pushVarint(codes, value);
+  }
+  ASSERT_EQ(codes.size(), 1 + 1 + 2 + 2 + 5);
+  size_t offset = 0;
+  for (uint32_t value : {0u, 127u, 128u, 300u, UINT32_MAX}) {
+    ASSERT_EQ(JSBytecode::readVarint(codes.data(), offset), value);
+  }
+  ASSERT_EQ(offset, codes.size());
+}
+
+TEST(TestBytecode, address) {
+  std::vector<uint8_t> codes(16);
+  JSBytecode::setAddress(codes, 12, 2);
+  JSBytecode::setAddress(codes, 4, 10);
+  size_t offset = 12;
+  ASSERT_EQ(JSBytecode::readAddress(codes.data(), offset), 2);
+  ASSERT_EQ(offset, 16);
+  offset = 4;
+  ASSERT_EQ(JSBytecode::readAddress(codes.data(), offset), 10);
+}
+
+TEST(TestBytecode, verify) {
+  auto runtime = new JSRuntime(0, nullptr);
+  auto &program = runtime->compile(
+      L"verify.js", L"let a = 1.5; for (let i = 0; i < 3; i++) { a += i; }\n"
+                    L"function f(x) { return x ? 'y' : 10n; }\n"
+                    L"label: while (true) { try { break label; } finally {} }");
+  ASSERT_EQ(program.error, nullptr);
+  ASSERT_TRUE(JSBytecode::verify(program));
+  auto codes = program.codes;
+  size_t fault = 0;
+  program.codes.push_back(0xff);
+  ASSERT_FALSE(JSBytecode::verify(program, 0, &fault));
+  ASSERT_EQ(fault, codes.size());
+  program.codes = codes;
+  program.codes.push_back((uint8_t)JS_OPERATOR::JMP);
+  JSBytecode::pushFixed(program.codes, 0);
+  JSBytecode::setAddress(program.codes, codes.size() + 1, codes.size() + 2);
+  ASSERT_FALSE(JSBytecode::verify(program, 0, &fault));
+  ASSERT_EQ(fault, codes.size());
+  program.codes = codes;
+  program.codes.push_back((uint8_t)JS_OPERATOR::LOAD);
+  JSBytecode::pushVarint(program.codes, program.identifiers.size());
+  ASSERT_FALSE(JSBytecode::verify(program));
+  program.codes = codes;
+  program.codes.push_back((uint8_t)JS_OPERATOR::PUSH);
+  ASSERT_FALSE(JSBytecode::verify(program));
+  delete runtime;
+}
+
+TEST(TestBytecode, toString) {
+  auto runtime = new JSRuntime(0, nullptr);
+  auto &program = runtime->compile(L"bytecode_string.js", L"let a = 1.5");
+  auto str = program.toString();
+  ASSERT_NE(str.find(L"PUSH 1.5"), std::wstring::npos);
+  ASSERT_NE(str.find(L"LET \"a\""), std::wstring::npos);
+  delete runtime;
+}
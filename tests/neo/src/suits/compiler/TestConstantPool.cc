@@ -0,0 +1,58 @@
+#include "script/compiler/JSProgram.hpp"
+#include "script/engine/JSContext.hpp"
+#include "script/engine/JSInfinityType.hpp"
+#include "script/engine/JSNaNType.hpp"
+#include "script/engine/JSRuntime.hpp"
+#include <gtest/gtest.h>
+
+TEST(TestConstantPool, resolve) {
+  JSConstantPool pool;
+  ASSERT_EQ(pool.resolve(L"a"), 0);
+  ASSERT_EQ(pool.resolve(L"b"), 1);
+  ASSERT_EQ(pool.resolve(L"a"), 0);
+  ASSERT_EQ(pool.size(), 2);
+  ASSERT_EQ(pool[1], L"b");
+}
+
+TEST(TestConstantPool, typedPools) {
+  auto runtime = new JSRuntime(0, nullptr);
+  auto &program = runtime->compile(
+      L"pools.js", L"let a = 'a'; let b = {a: a, c: 'a'}; let n = 12n + 12n;");
+  ASSERT_EQ(program.error, nullptr);
+  ASSERT_EQ(program.identifiers.size(), 3);
+  ASSERT_EQ(program.identifiers[program.identifiers.indices.at(L"a")], L"a");
+  ASSERT_EQ(program.strings.size(), 2);
+  ASSERT_TRUE(program.strings.indices.contains(L"c"));
+  ASSERT_EQ(program.bigintLiterals.size(), 1);
+  ASSERT_EQ(program.bigints.size(), 1);
+  delete runtime;
+}
+
+TEST(TestConstantPool, stringValues) {
+  auto runtime = new JSRuntime(0, nullptr);
+  auto ctx = new JSContext(runtime);
+  auto res = ctx->eval(L"string_values.js", L"let s = 'abc'; s += 'd'; 'abc'");
+  auto &program = runtime->getProgram(L"string_values.js");
+  ASSERT_EQ(program.stringValues.size(), program.strings.size());
+  auto index = program.strings.indices.at(L"abc");
+  ASSERT_EQ(res->getData()->cast<JSString>()->getRope(),
+            program.stringValues[index]);
+  ASSERT_EQ(program.stringValues[index]->flatten(), L"abc");
+  res = ctx->eval(L"nan_value.js", L"NaN");
+  ASSERT_TRUE(res->isTypeof<JSNaNType>());
+  ASSERT_FALSE(runtime->getProgram(L"nan_value.js")
+                   .identifiers.indices.contains(L"NaN"));
+  delete ctx;
+  delete runtime;
+}
+
+TEST(TestConstantPool, shorthandNaN) {
+  auto runtime = new JSRuntime(0, nullptr);
+  auto ctx = new JSContext(runtime);
+  auto res = ctx->eval(L"shorthand_nan.js", L"let o = {NaN}; o.NaN");
+  ASSERT_TRUE(res->isTypeof<JSNaNType>());
+  res = ctx->eval(L"shorthand_infinity.js", L"let p = {Infinity}; p.Infinity");
+  ASSERT_TRUE(res->isTypeof<JSInfinityType>());
+  delete ctx;
+  delete runtime;
+}
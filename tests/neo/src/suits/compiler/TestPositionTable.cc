@@ -0,0 +1,42 @@
+#include "script/compiler/JSPositionTable.hpp"
+#include <gtest/gtest.h>
+
+class TestPositionTable : public ::testing::Test {};
+
+TEST_F(TestPositionTable, find) {
+  JSPositionTable table;
+  for (size_t index = 0; index < 100; index++) {
+    table.push(index * 7, 1000 - index * 3 % 11, index % 80);
+  }
+  ASSERT_EQ(table.size(), 100);
+  JSPositionTable::Entry entry;
+  for (size_t index = 0; index < 100; index++) {
+    ASSERT_TRUE(table.find(index * 7, entry));
+    ASSERT_EQ(entry.line, 1000 - index * 3 % 11);
+    ASSERT_EQ(entry.column, index % 80);
+  }
+  ASSERT_FALSE(table.find(3, entry));
+  ASSERT_FALSE(table.find(10000, entry));
+  auto entries = table.getEntries();
+  ASSERT_EQ(entries.size(), 100);
+  ASSERT_EQ(entries[42].pc, 42 * 7);
+  ASSERT_EQ(entries[42].line, 1000 - 42 * 3 % 11);
+  ASSERT_LT(table.getByteSize(), 100 * 8);
+}
+
+TEST_F(TestPositionTable, truncate) {
+  JSPositionTable table;
+  for (size_t index = 0; index < 40; index++) {
+    table.push(index * 5, index + 1, index);
+  }
+  table.truncate(100);
+  ASSERT_EQ(table.size(), 20);
+  JSPositionTable::Entry entry;
+  ASSERT_TRUE(table.find(95, entry));
+  ASSERT_EQ(entry.line, 20);
+  ASSERT_FALSE(table.find(100, entry));
+  table.push(100, 7, 3);
+  ASSERT_TRUE(table.find(100, entry));
+  ASSERT_EQ(entry.line, 7);
+  ASSERT_EQ(entry.column, 3);
+}
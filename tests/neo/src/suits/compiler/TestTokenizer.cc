@@ -0,0 +1,84 @@
+#include "script/compiler/JSTokenizer.hpp"
+#include <cwchar>
+#include <gtest/gtest.h>
+
+TEST(TestTokenizer, symbol) {
+  JSTokenizer tokenizer;
+  std::wstring source = L">>>= ... a?.b ?? c";
+  tokenizer.reset(source);
+  ASSERT_EQ(tokenizer.readSymbol(source, 0), 4);
+  ASSERT_EQ(tokenizer.readSymbol(source, 5), 3);
+  ASSERT_EQ(tokenizer.readSymbol(source, 9), 0);
+  ASSERT_EQ(tokenizer.readSymbol(source, 10), 2);
+  ASSERT_EQ(tokenizer.readSymbol(source, 14), 2);
+  ASSERT_EQ(tokenizer.readSymbol(source, 0), 4);
+  std::wstring assigns = LR"(||= &&= ??= **= >>= >= => .. !==)";
+  tokenizer.reset(assigns);
+  ASSERT_EQ(tokenizer.readSymbol(assigns, 0), 3);
+  ASSERT_EQ(tokenizer.readSymbol(assigns, 4), 3);
+  ASSERT_EQ(tokenizer.readSymbol(assigns, 8), 3);
+  ASSERT_EQ(tokenizer.readSymbol(assigns, 12), 3);
+  ASSERT_EQ(tokenizer.readSymbol(assigns, 16), 3);
+  ASSERT_EQ(tokenizer.readSymbol(assigns, 20), 2);
+  ASSERT_EQ(tokenizer.readSymbol(assigns, 23), 2);
+  ASSERT_EQ(tokenizer.readSymbol(assigns, 26), 1);
+  ASSERT_EQ(tokenizer.readSymbol(assigns, 29), 3);
+}
+
+TEST(TestTokenizer, identifier) {
+  JSTokenizer tokenizer;
+  std::wstring source = L"$foo_1 + 2bar";
+  tokenizer.reset(source);
+  ASSERT_EQ(tokenizer.readIdentifier(source, 0), 6);
+  ASSERT_EQ(tokenizer.readIdentifier(source, 1), 5);
+  ASSERT_EQ(tokenizer.readIdentifier(source, 7), 0);
+  ASSERT_EQ(tokenizer.readIdentifier(source, 9), 0);
+  ASSERT_EQ(tokenizer.readIdentifier(source, 10), 3);
+  ASSERT_EQ(tokenizer.readSymbol(source, 7), 1);
+}
+
+TEST(TestTokenizer, string) {
+  JSTokenizer tokenizer;
+  std::wstring source = L"'a\\'b' \"c\" 'd";
+  tokenizer.reset(source);
+  ASSERT_EQ(tokenizer.readString(source, 0), 6);
+  ASSERT_EQ(tokenizer.readString(source, 7), 3);
+  ASSERT_EQ(tokenizer.readString(source, 11), JSTokenizer::UNTERMINATED);
+  ASSERT_EQ(tokenizer.readString(source, 11), JSTokenizer::UNTERMINATED);
+  ASSERT_EQ(tokenizer.readString(source, 1), 0);
+}
+
+TEST(TestTokenizer, reset) {
+  JSTokenizer tokenizer;
+  std::wstring source = L"abc";
+  tokenizer.reset(source);
+  ASSERT_EQ(tokenizer.readIdentifier(source, 0), 3);
+  std::wstring other = L"+=";
+  ASSERT_EQ(tokenizer.readIdentifier(other, 0), 0);
+  ASSERT_EQ(tokenizer.readSymbol(other, 0), 2);
+}
+
+TEST(TestTokenizer, keyword) {
+  for (auto keyword : {L"break", L"do", L"instanceof", L"let", L"static",
+                       L"typeof", L"with"}) {
+    ASSERT_TRUE(JSTokenizer::isKeyword(keyword, std::wcslen(keyword)));
+  }
+  for (auto name : {L"a", L"breaks", L"Do", L"instanceOf", L"lets", L"wit",
+                    L"undefined"}) {
+    ASSERT_FALSE(JSTokenizer::isKeyword(name, std::wcslen(name)));
+  }
+  ASSERT_TRUE(JSTokenizer::isKeyword(L"ifx", 2));
+}
+
+TEST(TestTokenizer, charClass) {
+  ASSERT_TRUE(JSTokenizer::isWhiteSpace(' '));
+  ASSERT_TRUE(JSTokenizer::isWhiteSpace(0xfeff));
+  ASSERT_FALSE(JSTokenizer::isWhiteSpace('\n'));
+  ASSERT_TRUE(JSTokenizer::isLineTerminator('\r'));
+  ASSERT_TRUE(JSTokenizer::isLineTerminator(0x2028));
+  ASSERT_FALSE(JSTokenizer::isLineTerminator(0));
+  ASSERT_TRUE(JSTokenizer::isIdentifierStart('$'));
+  ASSERT_FALSE(JSTokenizer::isIdentifierStart('1'));
+  ASSERT_TRUE(JSTokenizer::isIdentifierPart('1'));
+  ASSERT_FALSE(JSTokenizer::isIdentifierPart(-1));
+}
@@ -562,3 +562,24 @@ TEST_F(TestParser, ClassStaticBlock) {
   auto prop = dynamic_cast<JSStaticBlockNode *>(clazz->properties[0]);
   ASSERT_NE(prop->statement, nullptr);
 }
+
+TEST_F(TestParser, StatementLocation) {
+  JSParser parser{new JSAllocator};
+  std::wstring source = L"debugger;\r\n  debugger;\n\n    debugger;";
+  auto node = parser.parse(source);
+  ASSERT_EQ(node->type, JS_NODE_TYPE::PROGRAM);
+  auto program = dynamic_cast<JSProgramNode *>(node);
+  ASSERT_EQ(program->statements.size(), 3);
+  auto &first = program->statements[0]->location;
+  ASSERT_EQ(first.start.line, 1);
+  ASSERT_EQ(first.start.column, 1);
+  ASSERT_EQ(first.end.column, 10);
+  auto &second = program->statements[1]->location;
+  ASSERT_EQ(second.start.line, 2);
+  ASSERT_EQ(second.start.column, 3);
+  ASSERT_EQ(second.start.offset, 13);
+  auto &third = program->statements[2]->location;
+  ASSERT_EQ(third.start.line, 4);
+  ASSERT_EQ(third.start.column, 5);
+  delete node;
+}
@@ -0,0 +1,69 @@
+#include "script/engine/JSBinding.hpp"
+#include "script/engine/JSNativeFunction.hpp"
+#include "script/engine/JSRuntime.hpp"
+#include <gtest/gtest.h>
+
+class TestBinding : public ::testing::Test {};
+
+static double add(double a, int32_t b) { return a + b; }
+
+static std::wstring repeat(const std::wstring &value, int32_t count) {
+  std::wstring result;
+  for (int32_t index = 0; index < count; index++) {
+    result += value;
+  }
+  return result;
+}
+
+class Counter {
+private:
+  int32_t _value;
+
+public:
+  Counter(int32_t value) : _value(value) {}
+
+  void increase(int32_t step) { _value += step; }
+
+  int32_t getValue() const { return _value; }
+};
+
+TEST_F(TestBinding, function) {
+  auto runtime = new JSRuntime(0, NULL);
+  auto ctx = new JSContext(runtime);
+  auto fn = bind<&add>(ctx, L"add");
+  ASSERT_NE(fn->getData()->cast<JSNativeFunction>()->getEntry(), nullptr);
+  ctx->setField(ctx->getGlobal(), ctx->createString(L"add"), fn);
+  ctx->setField(ctx->getGlobal(), ctx->createString(L"repeat"),
+                bind<&repeat>(ctx, L"repeat"));
+  auto res = ctx->eval(L"add.js", L"add(1.5, 2)");
+  ASSERT_EQ(ctx->checkedNumber(res), 3.5);
+  res = ctx->eval(L"coerce.js", L"add('1', 2.9)");
+  ASSERT_EQ(ctx->checkedNumber(res), 3);
+  res = ctx->eval(L"missing.js", L"add()");
+  ASSERT_TRUE(res->isTypeof<JSNaNType>());
+  res = ctx->eval(L"repeat.js", L"repeat('ab', 3)");
+  ASSERT_EQ(ctx->checkedString(res), L"ababab");
+  delete ctx;
+  delete runtime;
+}
+
+TEST_F(TestBinding, clazz) {
+  auto runtime = new JSRuntime(0, NULL);
+  auto ctx = new JSContext(runtime);
+  JSClassBinding<Counter, int32_t> binding(ctx, L"Counter");
+  ASSERT_FALSE(ctx->isException(
+      binding.method<&Counter::increase>(L"increase")));
+  ASSERT_FALSE(ctx->isException(
+      binding.method<&Counter::getValue>(L"getValue")));
+  ctx->setField(ctx->getGlobal(), ctx->createString(L"Counter"),
+                binding.getConstructor());
+  auto res = ctx->eval(L"counter.js", L"let c = new Counter(40);\n"
+                                      L"c.increase(2);\n"
+                                      L"c.getValue()");
+  ASSERT_EQ(ctx->checkedNumber(res), 42);
+  res = ctx->eval(L"illegal.js", L"let o = {getValue: c.getValue};\n"
+                                 L"o.getValue()");
+  ASSERT_TRUE(ctx->isException(res));
+  delete ctx;
+  delete runtime;
+}
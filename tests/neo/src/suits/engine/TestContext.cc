@@ -1,7 +1,18 @@
 #include "script/engine/JSArray.hpp"
+#include "script/engine/JSBigInt.hpp"
+#include "script/engine/JSCallableType.hpp"
 #include "script/engine/JSContext.hpp"
+#include "script/engine/JSException.hpp"
+#include "script/engine/JSFunction.hpp"
+#include "script/engine/JSInfinityType.hpp"
+#include "script/engine/JSNaNType.hpp"
+#include "script/engine/JSNativeFunction.hpp"
+#include "script/engine/JSNumber.hpp"
 #include "script/engine/JSRuntime.hpp"
+#include "script/engine/JSString.hpp"
 #include "script/engine/JSUndefinedType.hpp"
+#include <cmath>
+#include <sstream>
 #include <gtest/gtest.h>
 class TestContext : public testing::Test {};
 TEST_F(TestContext, createNumber) {
@@ -16,7 +27,7 @@ TEST_F(TestContext, createNativeFunction) {
   auto runtime = new JSRuntime(0, NULL);
   auto ctx = new JSContext(runtime);
   auto fn = ctx->createNativeFunction(
-      [](JSContext *ctx, JSValue *self, std::vector<JSValue *> args)
+      [](JSContext *ctx, JSValue *self, JSArguments args)
           -> JSValue * { return ctx->createUndefined(); },
       L"test");
   ASSERT_TRUE(
@@ -57,4 +68,325 @@ TEST_F(TestContext, getFieldFromPrototype) {
   ASSERT_EQ(ctx->checkedNumber(val), 123);
   delete ctx;
   delete runtime;
-}
\ No newline at end of file
+}
+TEST_F(TestContext, addString) {
+  auto runtime = new JSRuntime(0, NULL);
+  auto ctx = new JSContext(runtime);
+  std::wstring part(100, L'a');
+  std::wstring expect;
+  auto str = ctx->createString(L"");
+  for (size_t index = 0; index < 100; index++) {
+    str = ctx->add(str, ctx->createString(part));
+    expect += part;
+  }
+  ASSERT_EQ(ctx->checkedString(str), expect);
+  auto res = ctx->concat({str, ctx->createNumber(1), ctx->createString(L"b")});
+  ASSERT_EQ(ctx->checkedString(res), expect + L"1b");
+  delete ctx;
+  delete runtime;
+}
+TEST_F(TestContext, cloneString) {
+  auto runtime = new JSRuntime(0, NULL);
+  auto ctx = new JSContext(runtime);
+  auto str = ctx->createString(std::wstring(1024, L'a'));
+  auto copy = ctx->clone(str);
+  ASSERT_NE(copy->getAtom(), str->getAtom());
+  ASSERT_EQ(copy->getData()->cast<JSString>()->getRope(),
+            str->getData()->cast<JSString>()->getRope());
+  ASSERT_EQ(ctx->toString(str), str);
+  delete ctx;
+  delete runtime;
+}
+TEST_F(TestContext, getPrimitiveField) {
+  auto runtime = new JSRuntime(0, NULL);
+  auto ctx = new JSContext(runtime);
+  auto str = ctx->createString(L"abc");
+  auto length = ctx->getField(str, ctx->createString(L"length"));
+  ASSERT_EQ(ctx->checkedNumber(length), 3);
+  auto ch = ctx->getField(str, ctx->createNumber(1));
+  ASSERT_EQ(ctx->checkedString(ch), L"b");
+  auto toString = ctx->getField(str, ctx->createString(L"toString"));
+  ASSERT_TRUE(toString->isTypeof<JSCallableType>());
+  ASSERT_EQ(ctx->checkedString(ctx->call(toString, str, {})), L"abc");
+  auto num = ctx->createNumber(12);
+  auto valueOf = ctx->getField(num, ctx->createString(L"valueOf"));
+  ASSERT_EQ(ctx->checkedNumber(ctx->call(valueOf, num, {})), 12);
+  delete ctx;
+  delete runtime;
+}
+TEST_F(TestContext, builtinPrototype) {
+  auto runtime = new JSRuntime(0, NULL);
+  auto ctx = new JSContext(runtime);
+  auto prototype = ctx->getField(ctx->getArrayConstructor(),
+                                 ctx->createString(L"prototype"));
+  ASSERT_EQ(ctx->getArrayPrototype()->getData(), prototype->getData());
+  auto arr = ctx->createArray();
+  ASSERT_EQ(ctx->getPrototypeOf(arr)->getData(), prototype->getData());
+  auto obj = ctx->createObject();
+  ASSERT_EQ(ctx->getPrototypeOf(obj)->getData(),
+            ctx->getObjectPrototype()->getData());
+  delete ctx;
+  delete runtime;
+}
+TEST_F(TestContext, typeMask) {
+  auto runtime = new JSRuntime(0, NULL);
+  auto ctx = new JSContext(runtime);
+  auto nan = ctx->createNaN();
+  ASSERT_TRUE(nan->isTypeof<JSNumberType>());
+  ASSERT_TRUE(nan->isTypeof<JSNaNType>());
+  ASSERT_FALSE(nan->isTypeof<JSInfinityType>());
+  ASSERT_EQ(nan->getData()->cast<JSNumber>(), nullptr);
+  auto arr = ctx->createArray();
+  ASSERT_TRUE(arr->isTypeof<JSObjectType>());
+  ASSERT_FALSE(arr->isTypeof<JSCallableType>());
+  ASSERT_NE(arr->getData()->cast<JSObject>(), nullptr);
+  ASSERT_NE(arr->getData()->cast<JSArray>(), nullptr);
+  ASSERT_EQ(arr->getData()->cast<JSCallable>(), nullptr);
+  auto func = ctx->createNativeFunction(
+      [](JSContext *ctx, JSValue *self, JSArguments args)
+          -> JSValue * { return ctx->createUndefined(); },
+      L"fn");
+  ASSERT_TRUE(func->isTypeof<JSCallableType>());
+  ASSERT_TRUE(func->isTypeof<JSObjectType>());
+  ASSERT_NE(func->getData()->cast<JSNativeFunction>(), nullptr);
+  ASSERT_EQ(func->getData()->cast<JSFunction>(), nullptr);
+  delete ctx;
+  delete runtime;
+}
+TEST_F(TestContext, integerArithmetic) {
+  auto runtime = new JSRuntime(0, NULL);
+  auto ctx = new JSContext(runtime);
+  auto sum = ctx->add(ctx->createNumber(2), ctx->createNumber(3));
+  ASSERT_TRUE(sum->getData()->cast<JSNumber>()->isInteger());
+  ASSERT_EQ(ctx->checkedNumber(sum), 5);
+  auto overflow = ctx->add(ctx->createInteger(INT32_MAX), ctx->createNumber(1));
+  ASSERT_FALSE(overflow->getData()->cast<JSNumber>()->isInteger());
+  ASSERT_EQ(ctx->checkedNumber(overflow), 2147483648.0);
+  auto zero = ctx->mul(ctx->createNumber(0), ctx->createNumber(-1));
+  ASSERT_FALSE(zero->getData()->cast<JSNumber>()->isInteger());
+  ASSERT_TRUE(std::signbit(ctx->checkedNumber(zero)));
+  auto shl = ctx->shl(ctx->createNumber(1), ctx->createNumber(31));
+  ASSERT_EQ(ctx->checkedNumber(shl), INT32_MIN);
+  auto bits = ctx->or_(ctx->createNumber(4294967297.0), ctx->createNumber(2));
+  ASSERT_EQ(ctx->checkedNumber(bits), 3);
+  delete ctx;
+  delete runtime;
+}
+TEST_F(TestContext, numberToString) {
+  auto runtime = new JSRuntime(0, NULL);
+  auto ctx = new JSContext(runtime);
+  auto format = [=](double value) -> std::wstring {
+    return ctx->checkedString(ctx->toString(ctx->createNumber(value)));
+  };
+  ASSERT_EQ(format(0), L"0");
+  ASSERT_EQ(format(-0.0), L"0");
+  ASSERT_EQ(format(42), L"42");
+  ASSERT_EQ(format(-7), L"-7");
+  ASSERT_EQ(format(0.1 + 0.2), L"0.30000000000000004");
+  ASSERT_EQ(format(1.5), L"1.5");
+  ASSERT_EQ(format(1e21), L"1e+21");
+  ASSERT_EQ(format(123456789012345680000.0), L"123456789012345680000");
+  ASSERT_EQ(format(0.000001), L"0.000001");
+  ASSERT_EQ(format(1e-7), L"1e-7");
+  ASSERT_EQ(format(-1.25e-10), L"-1.25e-10");
+  ASSERT_EQ(format(4294967296), L"4294967296");
+  delete ctx;
+  delete runtime;
+}
+TEST_F(TestContext, stringToNumber) {
+  auto runtime = new JSRuntime(0, NULL);
+  auto ctx = new JSContext(runtime);
+  auto parse = [=](const std::wstring &value) -> JSValue * {
+    return ctx->toNumber(ctx->createString(value));
+  };
+  ASSERT_EQ(ctx->checkedNumber(parse(L"  12.5\n")), 12.5);
+  ASSERT_EQ(ctx->checkedNumber(parse(L"")), 0);
+  ASSERT_EQ(ctx->checkedNumber(parse(L"-.5e1")), -5);
+  ASSERT_EQ(ctx->checkedNumber(parse(L"0x1F")), 31);
+  ASSERT_EQ(ctx->checkedNumber(parse(L"0o17")), 15);
+  ASSERT_EQ(ctx->checkedNumber(parse(L"0b101")), 5);
+  ASSERT_TRUE(parse(L"-Infinity")->isTypeof<JSInfinityType>());
+  ASSERT_TRUE(parse(L"1e400")->isTypeof<JSInfinityType>());
+  ASSERT_TRUE(parse(L"0.0001e313")->isTypeof<JSInfinityType>());
+  auto tiny = ctx->checkedNumber(parse(L"-1e-400"));
+  ASSERT_EQ(tiny, 0);
+  ASSERT_TRUE(std::signbit(tiny));
+  ASSERT_EQ(ctx->checkedNumber(parse(L"10000e-327")), 1e-323);
+  ASSERT_EQ(ctx->checkedNumber(parse(L"5e-324")), 5e-324);
+  ASSERT_EQ(ctx->checkedNumber(parse(L"-1e-310")), -1e-310);
+  ASSERT_TRUE(parse(L"1.8e308")->isTypeof<JSInfinityType>());
+  ASSERT_TRUE(parse(L"12px")->isTypeof<JSNaNType>());
+  ASSERT_TRUE(parse(L"0x")->isTypeof<JSNaNType>());
+  ASSERT_TRUE(parse(L".")->isTypeof<JSNaNType>());
+  ASSERT_TRUE(parse(L"1e")->isTypeof<JSNaNType>());
+  delete ctx;
+  delete runtime;
+}
+TEST_F(TestContext, callArguments) {
+  auto runtime = new JSRuntime(0, NULL);
+  auto ctx = new JSContext(runtime);
+  auto sub = ctx->createNativeFunction(
+      [](JSContext *ctx, JSValue *self, JSArguments args) -> JSValue * {
+        return ctx->createNumber(ctx->checkedNumber(args[0]) -
+                                 ctx->checkedNumber(args[1]));
+      },
+      L"sub");
+  JSValue *argv[] = {ctx->createNumber(5), ctx->createNumber(2)};
+  ASSERT_EQ(ctx->checkedNumber(ctx->call(sub, ctx->createUndefined(), argv, 2)),
+            3);
+  ctx->setField(ctx->getGlobal(), ctx->createString(L"sub"), sub);
+  auto res = ctx->eval(L"call.js", L"let o = {sub: sub}; o.sub(5, 2)");
+  ASSERT_EQ(ctx->checkedNumber(res), 3);
+  res = ctx->eval(L"construct.js", L"function F(a, b) { this.v = a - b; }\n"
+                                   L"new F(5, 2).v");
+  ASSERT_EQ(ctx->checkedNumber(res), 3);
+  delete ctx;
+  delete runtime;
+}
+TEST_F(TestContext, callStackTrace) {
+  auto runtime = new JSRuntime(0, NULL);
+  auto ctx = new JSContext(runtime);
+  auto res = ctx->eval(L"trace.js", L"function inner() { return missing; }\n"
+                                    L"function outer() { return inner(); }\n"
+                                    L"outer()");
+  ASSERT_TRUE(ctx->isException(res));
+  auto &stack = res->getData()->cast<JSException>()->getStack();
+  ASSERT_EQ(stack.size(), 3);
+  ASSERT_EQ(stack[0].position.funcname, L"neo.run");
+  ASSERT_EQ(stack[0].filename, L"trace.js");
+  ASSERT_EQ(stack[0].position.line, 3);
+  ASSERT_EQ(stack[1].position.funcname, L"outer");
+  ASSERT_EQ(stack[1].position.line, 2);
+  ASSERT_EQ(stack[2].position.funcname, L"inner");
+  ASSERT_EQ(ctx->getCallStack().size(), 1);
+  delete ctx;
+  delete runtime;
+}
+TEST_F(TestContext, lazyFunction) {
+  auto runtime = new JSRuntime(0, NULL);
+  auto ctx = new JSContext(runtime);
+  auto res = ctx->eval(L"lazy.js", L"let o = {base: 1};\n"
+                                   L"function unused() { return 0; }\n"
+                                   L"function outer(a) {\n"
+                                   L"  const add = (b) => a + b + o.base;\n"
+                                   L"  return add(2) * 10;\n"
+                                   L"}\n"
+                                   L"outer(3) + outer(4)");
+  ASSERT_EQ(ctx->checkedNumber(res), 130);
+  auto &program = runtime->getProgram(L"lazy.js");
+  ASSERT_EQ(program.lazyFunctions.size(), 3);
+  ASSERT_EQ(program.lazyPending, 1);
+  ASSERT_FALSE(program.source.empty());
+  delete ctx;
+  delete runtime;
+}
+TEST_F(TestContext, lazyFunctionError) {
+  auto runtime = new JSRuntime(0, NULL);
+  auto ctx = new JSContext(runtime);
+  auto res = ctx->eval(L"lazy_error.js", L"function f() { yield 1; }\n"
+                                         L"let o = {ok: 1};\n"
+                                         L"o.ok");
+  ASSERT_EQ(ctx->checkedNumber(res), 1);
+  res = ctx->eval(L"lazy_error_call.js", L"f()");
+  ASSERT_TRUE(ctx->isException(res));
+  runtime->setLazy(false);
+  res = ctx->eval(L"eager_error.js", L"function g() { yield 1; }");
+  ASSERT_TRUE(ctx->isException(res));
+  delete ctx;
+  delete runtime;
+}
+
+TEST_F(TestContext, evalStream) {
+  auto runtime = new JSRuntime(0, NULL);
+  auto ctx = new JSContext(runtime);
+  std::wstringstream source;
+  source << L"function add(a, b) { return a + b; }\nlet total = 0;\n";
+  for (size_t index = 0; index < 300; index++) {
+    source << L"total = add(total, 1); // " << std::wstring(200, 'x')
+           << L"\n";
+  }
+  source << L"let table = [\n";
+  for (size_t index = 0; index < 700; index++) {
+    source << (index ? L",\n" : L"") << L"'" << std::wstring(100, 'y')
+           << L"'";
+  }
+  source << L"];\nfunction getTotal() { return total; }\n"
+         << L"table.length + getTotal()";
+  auto res = ctx->evalStream(L"stream.js", source);
+  ASSERT_EQ(ctx->checkedNumber(res), 1000);
+  ASSERT_EQ(runtime->getProgram(L"stream.js").lazyFunctions.size(), 0);
+  delete ctx;
+  delete runtime;
+}
+
+TEST_F(TestContext, evalStreamError) {
+  auto runtime = new JSRuntime(0, NULL);
+  auto ctx = new JSContext(runtime);
+  std::wstringstream source;
+  for (size_t index = 0; index < 400; index++) {
+    source << L"let v" << index << L" = " << index << L"; // "
+           << std::wstring(200, 'x') << L"\n";
+  }
+  source << L"let = = 1;\n";
+  auto res = ctx->evalStream(L"stream_error.js", source);
+  ASSERT_TRUE(ctx->isException(res));
+  auto exception = res->getData()->cast<JSException>();
+  ASSERT_EQ(exception->getType(), JSException::TYPE::SYNTAX);
+  ASSERT_EQ(exception->getStack().rbegin()->position.line, 401);
+  res = ctx->eval(L"stream_error_value.js", L"v1");
+  ASSERT_EQ(ctx->checkedNumber(res), 1);
+  res = ctx->eval(L"stream_error_tail.js", L"v399");
+  ASSERT_TRUE(ctx->isException(res));
+  delete ctx;
+  delete runtime;
+}
+
+TEST_F(TestContext, bigintShiftRange) {
+  auto runtime = new JSRuntime(0, NULL);
+  auto ctx = new JSContext(runtime);
+  for (auto source : {L"1n << (1n << 64n)", L"1n << 1099511627776n",
+                      L"1n >> -(1n << 64n)"}) {
+    auto res = ctx->eval(source, source);
+    ASSERT_TRUE(ctx->isException(res));
+    ASSERT_EQ(res->getData()->cast<JSException>()->getType(),
+              JSException::TYPE::RANGE);
+  }
+  auto res = ctx->eval(L"shift_small.js", L"(-5n >> (1n << 64n)) + (3n << 2n)");
+  ASSERT_EQ(res->getData()->cast<JSBigInt>()->getValue(), BigInt<>(11));
+  res = ctx->eval(L"shift_zero.js", L"0n << (1n << 64n)");
+  ASSERT_EQ(res->getData()->cast<JSBigInt>()->getValue(), BigInt<>());
+  delete ctx;
+  delete runtime;
+}
+
+TEST_F(TestContext, bigintPowRange) {
+  auto runtime = new JSRuntime(0, NULL);
+  auto ctx = new JSContext(runtime);
+  for (auto source : {L"2n ** 4294967296n", L"3n ** (1n << 31n)",
+                      L"2n ** (1n << 64n)"}) {
+    auto res = ctx->eval(source, source);
+    ASSERT_TRUE(ctx->isException(res));
+    ASSERT_EQ(res->getData()->cast<JSException>()->getType(),
+              JSException::TYPE::RANGE);
+  }
+  auto res = ctx->eval(L"pow_unit.js", L"(-1n) ** (1n << 64n) + 1n ** (1n << "
+                                       L"64n) + 0n ** (1n << 64n) + 0n ** 0n");
+  ASSERT_EQ(res->getData()->cast<JSBigInt>()->getValue(), BigInt<>(3));
+  res = ctx->eval(L"pow_odd.js", L"(-1n) ** 3n + 2n ** 10n");
+  ASSERT_EQ(res->getData()->cast<JSBigInt>()->getValue(), BigInt<>(1023));
+  delete ctx;
+  delete runtime;
+}
+
+TEST_F(TestContext, toInt32NonFinite) {
+  auto runtime = new JSRuntime(0, NULL);
+  auto ctx = new JSContext(runtime);
+  for (auto raw : {NAN, INFINITY, -INFINITY}) {
+    auto value = ctx->getScope()->createValue(
+        ctx->getAllocator()->create<JSNumber>(raw));
+    auto res = ctx->shl(value, ctx->createNumber(1));
+    ASSERT_EQ(ctx->checkedNumber(res), 0);
+  }
+  delete ctx;
+  delete runtime;
+}
@@ -0,0 +1,55 @@
+#include "script/engine/JSNaNType.hpp"
+#include "script/engine/JSPreparedCall.hpp"
+#include "script/engine/JSRuntime.hpp"
+#include <cmath>
+#include <gtest/gtest.h>
+
+class TestPreparedCall : public ::testing::Test {};
+
+TEST_F(TestPreparedCall, invoke) {
+  auto runtime = new JSRuntime(0, NULL);
+  auto ctx = new JSContext(runtime);
+  ctx->eval(L"update.js", L"let state = {total: 0};\n"
+                          L"function update(dt, scale) {\n"
+                          L"  state.total = state.total + dt * scale;\n"
+                          L"  return state.total;\n"
+                          L"}");
+  auto call = new JSPreparedCall(ctx, ctx->queryValue(L"update"), nullptr, 2);
+  ASSERT_EQ(call->getArgumentCount(), 2);
+  call->setArgument(1, ctx->createNumber(2));
+  double result = 0;
+  for (int index = 1; index <= 4; index++) {
+    call->setArgument(0, (double)index);
+    ASSERT_EQ(call->invoke(result), nullptr);
+  }
+  ASSERT_EQ(result, 20);
+  call->setArgument(0, 0.5);
+  auto res = call->invoke();
+  ASSERT_EQ(ctx->checkedNumber(res), 21);
+  delete call;
+  call = new JSPreparedCall(ctx, ctx->createNumber(1));
+  ASSERT_TRUE(ctx->isException(call->invoke()));
+  delete call;
+  delete ctx;
+  delete runtime;
+}
+
+TEST_F(TestPreparedCall, nonFinite) {
+  auto runtime = new JSRuntime(0, NULL);
+  auto ctx = new JSContext(runtime);
+  ctx->eval(L"identity.js", L"function identity(x) { return x; }");
+  auto call =
+      new JSPreparedCall(ctx, ctx->queryValue(L"identity"), nullptr, 1);
+  call->setArgument(0, NAN);
+  ASSERT_TRUE(call->invoke()->isTypeof<JSNaNType>());
+  double result = 0;
+  call->setArgument(0, -INFINITY);
+  ASSERT_EQ(call->invoke(result), nullptr);
+  ASSERT_EQ(result, -INFINITY);
+  call->setArgument(0, 3.0);
+  ASSERT_EQ(call->invoke(result), nullptr);
+  ASSERT_EQ(result, 3);
+  delete call;
+  delete ctx;
+  delete runtime;
+}
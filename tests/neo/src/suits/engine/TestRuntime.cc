@@ -1,4 +1,5 @@
 #include "script/engine/JSVirtualMachine.hpp"
+#include "script/engine/JSContext.hpp"
 #include "script/engine/JSRuntime.hpp"
 #include <gtest/gtest.h>
 
@@ -37,4 +38,57 @@ TEST_F(TestRuntime, customGenerator) {
   runtime->setGenerator(generator);
   ASSERT_EQ(runtime->getGenerator(), generator);
   delete runtime;
-}
\ No newline at end of file
+}
+TEST_F(TestRuntime, compileAll) {
+  auto runtime = new JSRuntime(0, nullptr);
+  std::vector<std::pair<std::wstring, std::wstring>> sources;
+  for (size_t index = 0; index < 32; index++) {
+    auto name = L"all_" + std::to_wstring(index) + L".js";
+    sources.push_back({name, L"function f(a) { return a * 2; }\n"
+                             L"let o = {v: f(" +
+                                 std::to_wstring(index) + L")};\no.v"});
+  }
+  sources.push_back({L"all_error.js", L"let = ;"});
+  runtime->compileAll(sources, JS_EVAL_TYPE::PROGRAM, 4);
+  auto &reference = runtime->compile(L"all_serial.js", sources[5].second);
+  for (size_t index = 0; index < 32; index++) {
+    auto &program = runtime->getProgram(sources[index].first);
+    ASSERT_EQ(program.error, nullptr);
+    ASSERT_EQ(program.codes.size(), reference.codes.size());
+  }
+  ASSERT_EQ(runtime->getProgram(sources[5].first).codes, reference.codes);
+  ASSERT_NE(runtime->getProgram(L"all_error.js").error, nullptr);
+  auto ctx = new JSContext(runtime);
+  auto res = ctx->eval(sources[7].first, sources[7].second);
+  ASSERT_EQ(ctx->checkedNumber(res), 14);
+  delete ctx;
+  delete runtime;
+}
+
+TEST_F(TestRuntime, compileChunk) {
+  auto runtime = new JSRuntime(0, nullptr);
+  JSStreamState stream;
+  stream.buffer = L"let a = 1;\n  let b = a +\n 1; let c";
+  auto err = runtime->compileChunk(L"chunk.js", stream, false);
+  ASSERT_EQ(err, nullptr);
+  ASSERT_EQ(stream.line, 3);
+  ASSERT_EQ(stream.buffer, L"    let c");
+  ASSERT_EQ(stream.declared, std::set<std::wstring>({L"a", L"b"}));
+  auto size = runtime->getProgram(L"chunk.js").codes.size();
+  ASSERT_NE(size, 0);
+  stream.buffer += L" = b";
+  err = runtime->compileChunk(L"chunk.js", stream, false);
+  ASSERT_EQ(err, nullptr);
+  ASSERT_EQ(runtime->getProgram(L"chunk.js").codes.size(), size);
+  stream.buffer += L" +";
+  err = runtime->compileChunk(L"chunk.js", stream, true);
+  ASSERT_NE(err, nullptr);
+  ASSERT_EQ(err->location.end.line, 3);
+  runtime->getAllocator()->dispose(err);
+  stream.buffer += L" 1;";
+  err = runtime->compileChunk(L"chunk.js", stream, true);
+  ASSERT_EQ(err, nullptr);
+  ASSERT_TRUE(stream.buffer.empty());
+  ASSERT_TRUE(stream.declared.contains(L"c"));
+  delete runtime;
+}
@@ -1,5 +1,7 @@
+#include "script/engine/JSCallable.hpp"
 #include "script/engine/JSCallableType.hpp"
 #include "script/engine/JSContext.hpp"
+#include "script/engine/JSExceptionType.hpp"
 #include "script/engine/JSObjectType.hpp"
 #include "script/engine/JSRuntime.hpp"
 #include "script/util/JSRef.hpp"
@@ -42,4 +44,30 @@ TEST_F(TestFunction, prototype) {
   ASSERT_TRUE(proto->isTypeof<JSObjectType>());
   ASSERT_TRUE(ctx->checkedBoolean(ctx->isEqual(
       proto, ctx->getField(Object, ctx->createString(L"prototype")))));
-}
\ No newline at end of file
+}
+
+TEST_F(TestFunction, lazyProperties) {
+  auto fn = ctx->createFunction(L"test", L"test.js", 0);
+  ASSERT_TRUE(fn->getData()->cast<JSCallable>()->isLazy());
+  auto name = ctx->getField(fn, ctx->createString(L"name"));
+  ASSERT_FALSE(fn->getData()->cast<JSCallable>()->isLazy());
+  ASSERT_EQ(ctx->checkedString(name), L"test");
+  auto prototype = ctx->getField(fn, ctx->createString(L"prototype"));
+  ASSERT_TRUE(prototype->isTypeof<JSObjectType>());
+  ASSERT_TRUE(ctx->checkedBoolean(ctx->isEqual(
+      fn, ctx->getField(prototype, ctx->createString(L"constructor")))));
+}
+
+TEST_F(TestFunction, lazyPropertiesError) {
+  auto fn = ctx->createFunction(L"test", L"test.js", 0);
+  auto object = fn->getData()->cast<JSCallable>();
+  object->setExtensible(false);
+  auto name = ctx->getField(fn, ctx->createString(L"name"));
+  ASSERT_TRUE(name->isTypeof<JSExceptionType>());
+  ASSERT_TRUE(object->isLazy());
+  ASSERT_TRUE(object->getFields().empty());
+  object->setExtensible(true);
+  name = ctx->getField(fn, ctx->createString(L"name"));
+  ASSERT_EQ(ctx->checkedString(name), L"test");
+  ASSERT_FALSE(object->isLazy());
+}
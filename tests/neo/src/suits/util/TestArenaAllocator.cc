@@ -0,0 +1,35 @@
+#include "script/compiler/JSParser.hpp"
+#include "script/util/JSArenaAllocator.hpp"
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <string>
+
+TEST(TestArenaAllocator, alloc) {
+  JSArenaAllocator arena;
+  auto a = (char *)arena.alloc(3);
+  auto b = (char *)arena.alloc(8);
+  ASSERT_EQ((uintptr_t)a % JSArenaAllocator::ALIGNMENT, 0);
+  ASSERT_EQ((uintptr_t)b % JSArenaAllocator::ALIGNMENT, 0);
+  ASSERT_EQ(b - a, JSArenaAllocator::ALIGNMENT * 2);
+  arena.free(a);
+  ASSERT_EQ(arena.alloc(5), a);
+  ASSERT_EQ(arena.getBlockCount(), 1);
+  arena.alloc(JSArenaAllocator::BLOCK_SIZE * 2);
+  ASSERT_EQ(arena.getBlockCount(), 2);
+  arena.reset();
+  ASSERT_EQ(arena.getBlockCount(), 1);
+  ASSERT_EQ(arena.alloc(3), a);
+}
+
+TEST(TestArenaAllocator, parse) {
+  JSArenaAllocator arena;
+  JSParser parser{&arena};
+  std::wstring source = L"let a = [1, {b: 2}];\nfunction f(x) { return x; }";
+  for (auto index = 0; index < 3; index++) {
+    auto node = parser.parse(source);
+    ASSERT_EQ(node->type, JS_NODE_TYPE::PROGRAM);
+    arena.dispose(node);
+    arena.reset();
+    ASSERT_EQ(arena.getBlockCount(), 1);
+  }
+}
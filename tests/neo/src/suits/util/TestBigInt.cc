@@ -0,0 +1,67 @@
+#include "script/util/BigInt.hpp"
+#include <gtest/gtest.h>
+#include <string>
+class TestBigInt : public testing::Test {
+protected:
+  std::wstring repeat(const std::wstring &part, size_t count) {
+    std::wstring result;
+    for (size_t index = 0; index < count; index++) {
+      result += part;
+    }
+    return result;
+  }
+};
+TEST_F(TestBigInt, toString) {
+  ASSERT_EQ(BigInt<>(0).toString(), L"0");
+  ASSERT_EQ(BigInt<>(-42).toString(), L"-42");
+  ASSERT_EQ(BigInt<>(INT64_MIN).toString(), L"-9223372036854775808");
+  auto source = repeat(L"1234567890", 20);
+  ASSERT_EQ(BigInt<>(source).toString(), source);
+  ASSERT_EQ(BigInt<>(L"-000100").toString(), L"-100");
+  ASSERT_EQ(BigInt<>(L"10000000000000000000").toString(),
+            L"10000000000000000000");
+}
+TEST_F(TestBigInt, arithmetic) {
+  ASSERT_EQ(BigInt<>(2).pow(64).toString(), L"18446744073709551616");
+  ASSERT_EQ((BigInt<>(1) << 100).toString(),
+            L"1267650600228229401496703205376");
+  ASSERT_EQ((BigInt<>(-7) / 2).toString(), L"-3");
+  ASSERT_EQ((BigInt<>(-7) % 2).toString(), L"-1");
+  ASSERT_EQ((BigInt<>(-5) >> 1).toString(), L"-3");
+  ASSERT_EQ((BigInt<>(-6) & 3).toString(), L"2");
+  ASSERT_EQ((BigInt<>(-6) | 3).toString(), L"-5");
+  ASSERT_EQ((BigInt<>(-6) ^ 3).toString(), L"-7");
+  ASSERT_EQ((~BigInt<>(5)).toString(), L"-6");
+  ASSERT_TRUE(BigInt<>(-3) < BigInt<>(2));
+  ASSERT_TRUE(BigInt<>(L"18446744073709551616") > BigInt<>(INT64_MAX));
+  ASSERT_EQ(BigInt<>(INT64_MIN).toInt64(), INT64_MIN);
+  ASSERT_FALSE(BigInt<>(L"9223372036854775808").toInt64().has_value());
+}
+TEST_F(TestBigInt, largeOperands) {
+  BigInt<> a(repeat(L"1234567890", 200));
+  BigInt<> b(repeat(L"9876543210", 150));
+  auto product = (a * b).toString();
+  ASSERT_EQ(product.size(), 3500);
+  ASSERT_EQ(product.substr(0, 30), L"121932631137021795226185032733");
+  ASSERT_EQ(product.substr(3470), L"622923332237463801111263526900");
+  ASSERT_EQ((a + b) * (a - b), a * a - b * b);
+  auto quotient = a / b;
+  auto remainder = a % b;
+  ASSERT_EQ(quotient.toString().substr(0, 30),
+            L"124999998860937500014238281249");
+  ASSERT_EQ(remainder.toString().substr(0, 30),
+            L"834656688083465668808346566880");
+  ASSERT_EQ(quotient * b + remainder, a);
+}
+TEST_F(TestBigInt, decimalConversion) {
+  auto source = repeat(L"31415926535897932384", 400);
+  ASSERT_EQ(BigInt<>(source).toString(), source);
+  ASSERT_EQ(BigInt<>(L"-" + source).toString(), L"-" + source);
+  auto power = BigInt<>(10).pow(3000);
+  auto digits = L"1" + std::wstring(3000, L'0');
+  ASSERT_EQ(power.toString(), digits);
+  ASSERT_EQ(BigInt<>(digits), power);
+  auto padded = BigInt<>(10).pow(19 * 64) + 1;
+  auto expected = L"1" + std::wstring(19 * 64 - 1, L'0') + L"1";
+  ASSERT_EQ(padded.toString(), expected);
+}